@@ -18,358 +18,303 @@
 #include <xc.h>
 #define _XTAL_FREQ 20000000
 
-// ---------- LCD CONNECTIONS ----------
-#define RS RB0
-#define RW RB1
-#define EN RB2
-#define LCD PORTD
+#include "board.h"
+#include "common/sched.h"
+#include "common/fmt.h"
+#include "common/probe.h"
+#include "common/uart.h"
+#include "common/lcd.h"
+#include "common/i2c.h"
+#include "common/ds1307.h"
+#include "common/bcd.h"
+#include "common/console.h"
+#include "common/irq.h"
 
 // ---------- BUTTONS ----------
-#define SET_BTN 1   // RA0
-#define INC_BTN 2   // RA1
-#define NEXT_BTN 3  // RA2
-#define ALARM_BTN 4   // RA3
+#define SET_BTN 0x01   // RA0
+#define INC_BTN 0x02   // RA1
+#define NEXT_BTN 0x04  // RA2
+#define ALARM_BTN 0x08   // RA3
+#define BTN_MASK 0x0F
+#define DEBOUNCE_SAMPLES 5   // x BUTTON_PERIOD_MS = 50 ms stable
 #define BUZZER RC0
 
+// ---------- TASK RATES ----------
+#define BUTTON_PERIOD_MS 10
+#define RTC_PERIOD_MS 200
+#define BLINK_PERIOD_MS 500
+#define ALARM_RING_MS 3000
+#define SPLASH_MS 2000
+
 // ---------- GLOBAL VARIABLES ----------
+// Times are packed BCD, as the DS1307 keeps them: read, compared, edited
+// and shown without converting to binary
 unsigned char sec, min, hr;
-unsigned char alarm_hr = 12, alarm_min = 54;   // Default alarm time
+unsigned char alarm_hr = 0x12, alarm_min = 0x54;   // Default alarm time, saved by the console
 unsigned char mode = 0; // 0 = Normal, 1 = Set Time, 2 = Set Alarm
 unsigned char alarm_triggered = 0;
+unsigned char alarm_ringing = 0;
+unsigned char set_hr, set_min;  // values being edited in mode 1/2
+unsigned char field = 0;        // 0 = hour, 1 = minute
+unsigned char blink = 0;
+unsigned char redraw = 1;       // LCD content is stale
+unsigned char shown_sec = 0xFF;
+unsigned char splash = 1;       // title on the LCD until SPLASH_MS or a button
 
 
 // ---------- BUTTON READ (Active Low, Debounced) ----------
-// BUTTON READ (Active Low, Debounced)
-unsigned char read_button(unsigned char button_pin) {
-    if(button_pin == 1) { // SET_BTN -> RA0
-        if(!(PORTA & 0x01)) {       // check RA0
-            __delay_ms(50);          // debounce
-            if(!(PORTA & 0x01)) {    // still pressed
-                while(!(PORTA & 0x01)); // wait release
-                __delay_ms(50);
-                return 1;
-            }
-        }
-    }
-    else if(button_pin == 2) { // INC_BTN -> RA1
-        if(!(PORTA & 0x02)) {       
-            __delay_ms(50);          
-            if(!(PORTA & 0x02)) {    
-                while(!(PORTA & 0x02));
-                __delay_ms(50);
-                return 1;
-            }
-        }
+unsigned char btn_raw, btn_stable, btn_settle;
+unsigned char btn_events;       // press edges not yet handled
+
+// Sampled every BUTTON_PERIOD_MS; a press registers once the pins have
+// been stable for DEBOUNCE_SAMPLES samples
+void button_task(void) {
+    unsigned char raw = ~PORTA & BTN_MASK;
+    if(raw != btn_raw) {
+        btn_raw = raw;
+        btn_settle = 0;
+        return;
     }
-    else if(button_pin == 3) { // NEXT_BTN -> RA2
-        if(!(PORTA & 0x04)) {       
-            __delay_ms(50);          
-            if(!(PORTA & 0x04)) {    
-                while(!(PORTA & 0x04));
-                __delay_ms(50);
-                return 1;
-            }
-        }
+    if(btn_settle < DEBOUNCE_SAMPLES && ++btn_settle == DEBOUNCE_SAMPLES) {
+        btn_events |= raw & ~btn_stable;
+        btn_stable = raw;
     }
-    else if(button_pin == 4) { // ALARM_BTN -> RA3
-    if(!(PORTA & 0x08)) {       
-        __delay_ms(50);          
-        if(!(PORTA & 0x08)) {    
-            while(!(PORTA & 0x08)); 
-            __delay_ms(50);
-            return 1;
-        }
-    }
-}
-    return 0; // not pressed
-}
-
-void lcd_cmd(char cmd) {
-    RS = 0; RW = 0;
-    LCD = cmd;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
 }
 
-void lcd_data(char data) {
-    RS = 1; RW = 0;
-    LCD = data;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
-
-void lcd_init() {
-    lcd_cmd(0x38); // 8-bit, 2-line
-    lcd_cmd(0x0C); // display ON
-    lcd_cmd(0x06); // entry mode
-    lcd_cmd(0x01); // clear display
-    __delay_ms(2);
-}
-
-void lcd_string(const char *str) {
-    while (*str) 
-        lcd_data(*str++);
-}
-
-void I2C_wait_idle(void) {
-    while ((SSPCON2 & 0x1F) || (SSPSTAT & 0x04));
-}
-
-void I2C_init(void) {
-    SSPCON = 0x28; // enable I2C Master mode
-    SSPADD = ((_XTAL_FREQ/4)/100000) - 1; // 100kHz
-    SSPSTAT = 0x80;
-}
-
-void I2C_start(void) {
-    I2C_wait_idle(); 
-    SEN = 1;
-    while (SEN);
-}
-
-void I2C_stop(void) {
-    I2C_wait_idle(); 
-    PEN = 1; 
-    while (PEN);
-}
-
-void I2C_repeated_start(void) {
-    I2C_wait_idle(); 
-    RSEN = 1; 
-    while (RSEN);
-}
-
-unsigned char I2C_write(unsigned char data) {
-    I2C_wait_idle();
-    SSPBUF = data;
-    while (!SSPIF); 
-    SSPIF = 0;
-    return !SSPCON2bits.ACKSTAT;
-}
-
-unsigned char I2C_read(unsigned char ack) {
-    I2C_wait_idle();
-    RCEN = 1;
-    while (!BF);
-    unsigned char data = SSPBUF;
-    I2C_wait_idle();
-    ACKDT = (ack) ? 0 : 1;
-    ACKEN = 1;
-    while (ACKEN);
-    return data;
+unsigned char read_button(unsigned char button) {
+    if(btn_events & button) {
+        btn_events &= ~button;
+        return 1;
+    }
+    return 0; // not pressed
 }
 
-unsigned char BCD_to_DEC(unsigned char value) {
-    return ((value >> 4) * 10) + (value & 0x0F);
-}
-
-unsigned char DEC_to_BCD(unsigned char value) {
-    return ((value / 10) << 4) | (value % 10);
-}
+// Cycle probes (built with -DPROBES, dumped with 'P' on the console); ids
+// in board.h
+#ifdef PROBES
+probe_t probes[] = {
+    PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("I2C_start"), PROBE("I2C_stop"),
+    PROBE("I2C_rstart"), PROBE("I2C_write"), PROBE("I2C_read"),
+};
+#endif
 
 void RTC_write_time(unsigned char h, unsigned char m, unsigned char s) {
-    I2C_start();
-    I2C_write(0xD0);
-    I2C_write(0x00);
-    I2C_write(DEC_to_BCD(s));
-    I2C_write(DEC_to_BCD(m));
-    I2C_write(DEC_to_BCD(h));
-    I2C_stop();
+    unsigned char r[3];
+    r[0] = s;   // CH = 0, the clock runs
+    r[1] = m;
+    r[2] = h;   // bit 6 = 0: 24-hour mode
+    ds1307_write(DS1307_SEC, r, sizeof(r));
 }
 
 void RTC_read_time(void) {
-    unsigned char s, m, h;
-    I2C_start();
-    I2C_write(0xD0);
-    I2C_write(0x00);
-    I2C_repeated_start();
-    
-    I2C_write(0xD1);
-    s = I2C_read(1);
-    m = I2C_read(1);
-    h = I2C_read(0);
-    I2C_stop();
-
-    sec = BCD_to_DEC(s & 0x7F);
-    min = BCD_to_DEC(m);
-    hr  = BCD_to_DEC(h & 0x3F);
+    unsigned char r[3];     // sec, min, hr
+    if(!ds1307_read(DS1307_SEC, r, sizeof(r))) return;
+
+    sec = r[0] & 0x7F;   // mask CH
+    min = r[1];
+    hr  = r[2] & 0x3F;
 }
 
 void show_time_on_lcd() {
+    char buf[9], *p = buf;
+
     lcd_cmd(0x80);
     lcd_string("Time: ");
-    lcd_data((hr/10)+'0');
-    lcd_data((hr%10)+'0');
-    lcd_data(':');
-    lcd_data((min/10)+'0');
-    lcd_data((min%10)+'0');
-    lcd_data(':');
-    lcd_data((sec/10)+'0');
-    lcd_data((sec%10)+'0');
+    p = fmt_bcd(p, hr);
+    *p++ = ':';
+    p = fmt_bcd(p, min);
+    *p++ = ':';
+    fmt_bcd(p, sec);
+    lcd_string(buf);
 
     lcd_cmd(0xC0);
     lcd_string("Alarm:");
-    lcd_data((alarm_hr/10)+'0');
-    lcd_data((alarm_hr%10)+'0');
-    lcd_data(':');
-    lcd_data((alarm_min/10)+'0');
-    lcd_data((alarm_min%10)+'0');
+    p = fmt_bcd(buf, alarm_hr);
+    *p++ = ':';
+    fmt_bcd(p, alarm_min);
+    lcd_string(buf);
 }
 
 // ---------- Alarm Trigger ----------
+enum { TASK_BUTTON, TASK_UI, TASK_ALARM_OFF, TASK_RTC, TASK_BLINK, TASK_DISPLAY };
+
 void check_alarm(void) {
     if(hr == alarm_hr && min == alarm_min && sec == 0 && alarm_triggered == 0) {
         alarm_triggered = 1;
-        lcd_cmd(0x01);
-        lcd_string("ALARM RINGING!");
+        alarm_ringing = 1;
         BUZZER = 1;
-        __delay_ms(3000);
-        BUZZER = 0;
-        lcd_cmd(0x01);
+        redraw = 1;
+        sched_wake(TASK_ALARM_OFF, ALARM_RING_MS);
     }
     if(min != alarm_min) alarm_triggered = 0;
 }
 
+void alarm_off_task(void) {
+    BUZZER = 0;
+    alarm_ringing = 0;
+    redraw = 1;
+}
 
-// Utility: Print 2-digit number or blank if blinking
+
+// Utility: Print 2-digit BCD number or blank if blinking
 void lcd_print_blink(unsigned char value, unsigned char blink) {
     if(blink) {
         lcd_data(' ');
         lcd_data(' ');
     } else {
-        lcd_data((value/10)+'0');
-        lcd_data((value%10)+'0');
+        char buf[3];
+        fmt_bcd(buf, value);
+        lcd_string(buf);
     }
 }
 
-
-void adjust_time(void) {
-    unsigned char set_hr = hr;
-    unsigned char set_min = min;
-    unsigned char field = 0; // 0 = hour, 1 = minute
-    unsigned char blink = 0;
-
+// ---------- TASKS ----------
+void enter_set_mode(unsigned char m) {
+    mode = m;
+    set_hr = (m == 1) ? hr : alarm_hr;
+    set_min = (m == 1) ? min : alarm_min;
+    field = 0;
+    blink = 0;
+    redraw = 1;
     lcd_cmd(0x01);
-    lcd_string("Set Time Mode");
-    __delay_ms(1000);
-
-    while(1) {
-        lcd_cmd(0xC0);
-
-        // Print hour
-        if(field == 0) 
-            lcd_print_blink(set_hr, blink);
-        else lcd_print_blink(set_hr, 0);
+    lcd_string(m == 1 ? "Set Time Mode" : "Set Alarm Mode");
+}
 
-        lcd_data(':');
+// Button handling for all modes, replaces the blocking adjust loops
+void ui_task(void) {
+    if(!btn_events) return;
 
-        // Print minute
-        if(field == 1) 
-            lcd_print_blink(set_min, blink);
-        else lcd_print_blink(set_min, 0);
-
-        blink = !blink;
-        __delay_ms(500);
+    if(mode == 0) {
+        if(read_button(SET_BTN)) enter_set_mode(1);        // Set Time mode
+        else if(read_button(ALARM_BTN)) enter_set_mode(2); // Set Alarm mode
+        btn_events = 0;
+        return;
+    }
 
-        if(read_button(INC_BTN)) {
-            if(field == 0) set_hr = (set_hr + 1) % 24;
-            else set_min = (set_min + 1) % 60;
-        }
-        if(read_button(NEXT_BTN)) field = !field;
-        if(read_button(SET_BTN)) {
-            RTC_write_time(set_hr,set_min,0);
-            mode = 0;
-            lcd_cmd(0x01);
-            break;
+    if(read_button(INC_BTN)) {
+        if(field == 0) set_hr = bcd_inc(set_hr, 0x00, 0x23);
+        else set_min = bcd_inc(set_min, 0x00, 0x59);
+        blink = 0;    // show the new value straight away
+    }
+    if(read_button(NEXT_BTN)) field = !field;
+    if(read_button(SET_BTN)) {   // confirmation to save
+        if(mode == 1) RTC_write_time(set_hr, set_min, 0);
+        else {
+            alarm_hr = set_hr;
+            alarm_min = set_min;
+            console_save(&alarm_hr);
+            console_save(&alarm_min);
         }
+        mode = 0;
+        shown_sec = 0xFF;
+        lcd_cmd(0x01);
     }
+    btn_events = 0;
+    redraw = 1;
+    sched_wake(TASK_DISPLAY, 0);
 }
 
-void adjust_alarm(void) {
-    unsigned char set_hr = alarm_hr;
-    unsigned char set_min = alarm_min;
-    unsigned char field = 0; // 0 = hour, 1 = minute
-    unsigned char blink = 0;
+void rtc_task(void) {
+    if(mode != 0) return;
+    RTC_read_time();
+    check_alarm();
+    if(sec != shown_sec) redraw = 1;
+}
 
-    lcd_cmd(0x01);
-    lcd_string("Set Alarm Mode");
-    __delay_ms(1000);
+void blink_task(void) {
+    if(mode == 0) return;
+    blink = !blink;
+    redraw = 1;
+}
 
-    while(1) {
-        lcd_cmd(0xC0);
+void display_task(void) {
+    if(splash) {
+        if(mode == 0 && !alarm_ringing && tick_now() < SPLASH_MS) return;
+        splash = 0;
+    }
+    if(!redraw) return;
+    redraw = 0;
 
+    if(mode != 0) {
+        lcd_cmd(0xC0);
         // Print hour
-        if(field == 0) 
-            lcd_print_blink(set_hr, blink);
-        else lcd_print_blink(set_hr, 0);
-
+        lcd_print_blink(set_hr, field == 0 && blink);
         lcd_data(':');
-
         // Print minute
-        if(field == 1) 
-            lcd_print_blink(set_min, blink);
-        else lcd_print_blink(set_min, 0);
-
-        blink = !blink;
-        __delay_ms(500);
-
-        if(read_button(INC_BTN)) {
-            if(field == 0) set_hr = (set_hr + 1) % 24;
-            else set_min = (set_min + 1) % 60;
-        }
-
-        if(read_button(NEXT_BTN)) field = !field;
-
-        if(read_button(SET_BTN)) {   // confirmation to save alarm
-            alarm_hr = set_hr;
-            alarm_min = set_min;
-            mode = 0;
-            lcd_cmd(0x01);
-            break;
-        }
+        lcd_print_blink(set_min, field == 1 && blink);
+    } else if(alarm_ringing) {
+        lcd_cmd(0x01);
+        lcd_string("ALARM RINGING!");
+        shown_sec = 0xFF;
+    } else {
+        if(shown_sec == 0xFF) lcd_cmd(0x01);
+        show_time_on_lcd();
+        shown_sec = sec;
     }
 }
 
+sched_task_t tasks[] = {
+    SCHED_TASK(button_task,    BUTTON_PERIOD_MS, 0,   200),
+    SCHED_TASK(ui_task,        BUTTON_PERIOD_MS, 1,   5000),
+    SCHED_ONESHOT(alarm_off_task, 5000),
+    SCHED_TASK(rtc_task,       RTC_PERIOD_MS,    2,   3000),
+    SCHED_TASK(blink_task,     BLINK_PERIOD_MS,  3,   100),
+    SCHED_TASK(display_task,   50,               4,   5000),
+    SCHED_TASK(console_task,   5,                5,   300),
+};
+
+// Stored form of the settings for console_init(): 1 since the alarm is
+// kept in BCD, so a binary alarm saved by older firmware reads as absent
+#define SETTINGS_FORMAT 1
+
+const console_var_t settings[] = {
+    CONSOLE_BCD("alarm_hr", alarm_hr, 0x00, 0x23),
+    CONSOLE_BCD("alarm_min", alarm_min, 0x00, 0x59),
+    CONSOLE_U16("rtc_ms", tasks[TASK_RTC].period, 50, 1000),
+};
+
+const console_stat_t counters[] = {
+    CONSOLE_STAT("rx_drop", uart_rx_dropped),
+    CONSOLE_STAT("rx_over", uart_rx_overruns),
+    CONSOLE_STAT("irq_lost", irq_unhandled),
+};
+
+#ifdef IRQ_STATS
+const console_cmd_t commands[] = { CONSOLE_CMD("irq", irq_cmd) };
+#endif
 
 void main(void) {
     ADCON1 = 0x06; // disable ADC
     CMCON = 0x07;  // disable comparator
 
-    TRISB = 0x00;  // LCD output
-    TRISD = 0x00;
+    TRISB = 0x00;  // LCD control, spare pins output
     TRISA = 0xFF;  // buttons input
+    BUZZER = 0;    // latch before TRIS: silent from reset
     TRISC0 = 0;    // buzzer output
 
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
     lcd_init();
-    I2C_init();
+    i2c_init();
+    ds1307_start();
+    tick_init();
+    uart_init();
+    console_init(settings, sizeof(settings) / sizeof(settings[0]),
+                 counters, sizeof(counters) / sizeof(counters[0]), SETTINGS_FORMAT);
+#ifdef IRQ_STATS
+    console_commands(commands, sizeof(commands) / sizeof(commands[0]));
+#endif
+    irq_register(IRQ_TMR2, tick_isr);
+    irq_register(IRQ_RX, uart_rx_isr);
+    irq_register(IRQ_TX, uart_tx_isr);
+    ei();
 
     lcd_cmd(0x80);
     lcd_string("Digital Clock");
     lcd_cmd(0xC0);
-    lcd_string("With Alarm");
-    __delay_ms(2000);
-    lcd_cmd(0x01);
+    lcd_string("With Alarm");   // display_task takes over after SPLASH_MS
 
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
     while(1) {
-    if(read_button(SET_BTN)) {
-        __delay_ms(100);
-        mode = 1;   // Set Time mode
-    }
-
-    if(read_button(ALARM_BTN)) {
-        __delay_ms(100);
-        mode = 2;   // Set Alarm mode
-    }
-
-    if(mode == 1) adjust_time();
-    else if(mode == 2) adjust_alarm();
-    else {
-        RTC_read_time();
-        show_time_on_lcd();
-        check_alarm();
-        __delay_ms(900);
+        sched_run();
     }
-  }
 }
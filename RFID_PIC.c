@@ -29,134 +29,278 @@
 #include <xc.h>
 #include  <string.h>
 #define _XTAL_FREQ 20000000
-#define baud_rate 9600
 #define tag_length 12
+#define SPLASH_MS 2000   //"UART Initialize" before "Scan RF ID"
 
-// LCD connections
-#define RS RB0
-#define RW RB1
-#define EN RB2
-#define LCD PORTD
-
-// LCD Functions
-void lcd_cmd(char cmd) {
-    RS = 0;
-    RW = 0;
-    LCD = cmd;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
+#include "board.h"
+#include "common/sched.h"
+#include "common/uart.h"
+#include "common/probe.h"
+#include "common/lcd.h"
+#include "common/console.h"
+#include "common/i2c.h"
+#include "common/journal.h"
+#include "common/irq.h"
+
+// Cycle probes (built with -DPROBES, dumped with 'P' on the USART); ids
+// in board.h
+#ifdef PROBES
+probe_t probes[] = {
+    PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("uart_rx"),
+    PROBE("I2C_start"), PROBE("I2C_stop"), PROBE("I2C_rstart"), PROBE("I2C_write"), PROBE("I2C_read"),
+};
+#endif
+
+// ---------- TASKS ----------
+// Settings, changed from the console and saved in data EEPROM
+char valid_tag[tag_length + 1] = "123412341234"; //authorized ID 
+uint16_t show_id_ms = 2000;   //tag ID on screen before the verdict
+uint16_t verdict_ms = 2000;   //verdict on screen before "Next SCAN ID..."
+uint16_t holdoff_ms = 3000;   //a tag read again within this is a repeat, 0 = off
+
+char TAG[tag_length + 1];  //tag being shown/decided, +1 for null terminator 
+char rx_tag[tag_length];   //frame being received
+unsigned char tag_pos = 0;
+unsigned char tag_ready = 0; //TAG holds a new tag for ui_task
+unsigned char ui_state = 3;  //0 = waiting, 1 = showing ID, 2 = showing verdict, 3 = splash
+uint16_t last_rx;            //tick of the last byte, for frame resync
+
+// ---------- RECENT TAGS ----------
+// The reader sends a held card again and again. Tags decided in the last
+// holdoff_ms are kept here, most recently decided first; a read that matches
+// one only refreshes its time, and a read of the card still on screen
+// waiting for its verdict is dropped, so a held card is decided once and
+// the screen, the USART and the UI sequence stay free for the next
+// different card. A card cut short by another one was never decided, so it
+// is not in the cache and is judged when it is presented again.
+#define TAG_CACHE 4          //tags remembered
+#define TAG_GAP_MS 20        //silence that abandons a part-received frame
+
+typedef struct {
+    unsigned char id[tag_length / 2];   //two hex characters per byte
+    uint16_t seen;                      //tick of the last read
+    unsigned char used;
+} tag_entry_t;
+
+tag_entry_t tag_cache[TAG_CACHE];
+unsigned char tag_sweep;     //next entry checked for expiry
+uint16_t tag_repeats;        //reads of a held card dropped
 
-void lcd_data(char data) {
-    RS = 1;
-    RW = 0;
-    LCD = data;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
+unsigned char hex_nibble(char c){
+    return (c <= '9') ? (c - '0') : ((c & 0x07) + 9);
 }
 
-void lcd_init() {
-    lcd_cmd(0x38); // 8-bit, 2-line
-    lcd_cmd(0x0C); // display ON
-    lcd_cmd(0x06); // entry mode
-    lcd_cmd(0x01); // clear display
+void tag_pack(const char *t, unsigned char *id){
+    for(unsigned char i = 0; i < tag_length / 2; i++){
+        id[i] = (hex_nibble(t[2 * i]) << 4) | hex_nibble(t[2 * i + 1]);
+    }
 }
 
+// Returns 1 for a tag decided in the last holdoff_ms, and refreshes its
+// time so it stays a repeat for as long as the card is held
+unsigned char tag_cache_seen(const char *t){
+    unsigned char id[tag_length / 2];
+    uint16_t now = tick_now();
+
+    tag_pack(t, id);
+    for(unsigned char i = 0; i < TAG_CACHE; i++){
+        tag_entry_t *e = &tag_cache[i];
+        if(!e->used || memcmp(e->id, id, sizeof(id)) != 0) continue;
+        if((uint16_t)(now - e->seen) >= holdoff_ms) return 0;
+        e->seen = now;
+        return 1;
+    }
+    return 0;
+}
 
+// Called with the verdict: the tag moves to the front with the current
+// time, the least recently decided entry making room for a new one
+void tag_cache_decided(const char *t){
+    tag_entry_t e;
+    unsigned char i;
 
-void UART_int(){
-   
-    TRISC6 = 0; //R6 AS OUTPUT
-    TRISC7 = 1;  //R7 AS INPUT
-    
-    SPBRG = ((_XTAL_FREQ/16)/baud_rate)-1;   //or it can be set to 129 refers 9600 baud rate for more observe datasheet    
-    
-    BRGH = 1;
-    SYNC = 0;//SYNCHRONIZATION 
-    SPEN = 1;
-    TXEN = 1;
-    CREN = 1;
+    tag_pack(t, e.id);
+    for(i = 0; i < TAG_CACHE - 1; i++){     //no match leaves i on the last entry
+        if(tag_cache[i].used && memcmp(tag_cache[i].id, e.id, sizeof(e.id)) == 0) break;
+    }
+    for(; i > 0; i--) tag_cache[i] = tag_cache[i - 1];
+    e.seen = tick_now();
+    e.used = 1;
+    tag_cache[0] = e;
 }
 
-//send character
-void uart_send_char(char a){
-    while(!TXIF);  //transistor interrupt flag
-                   //TXIF = 1 ? Buffer is empty ? ready to send.
-                   //TXIF = 0 ? Buffer is full ? must wait.
-    TXREG = a;
+// Drop entries older than holdoff_ms, one per call, before the 16-bit
+// tick wraps and makes an old entry look recent again
+void tag_cache_sweep(void){
+    tag_entry_t *e = &tag_cache[tag_sweep];
+    if(e->used && (uint16_t)(tick_now() - e->seen) >= holdoff_ms) e->used = 0;
+    if(++tag_sweep == TAG_CACHE) tag_sweep = 0;
 }
 
-//SEND string
-void lcd_string(const char *str){
-    while(*str)
-    lcd_data(*str++);
+enum { TASK_RX, TASK_UI, TASK_CONSOLE, TASK_JOURNAL };
+
+//collect the 12-byte RFID tag without waiting on RCIF. The reader and the
+//console share RX: a tag is hex digits, a command starts with a lowercase
+//letter and runs to CR/LF. While a command line waits for console_poll()
+//the bytes behind it stay in the receive ring, tag or not
+void rx_task(void){
+    while(!console_line_waiting() && uart_rx_ready()){
+        PROBE_ENTER(P_UART_RX);
+        char c = uart_rx();
+        PROBE_EXIT(P_UART_RX);
+#ifdef PROBES
+        if(c == PROBE_CMD){       //never part of a tag (hex digits only)
+            probe_dump_start();
+            continue;
+        }
+#endif
+        if(console_in_line() || (c >= 'a' && c <= 'z')){
+            console_byte(c);
+            continue;
+        }
+        last_rx = tick_now();
+        rx_tag[tag_pos++] = c;
+        if(tag_pos == tag_length){
+            tag_pos = 0;
+            //a held card, already decided or still waiting for its verdict
+            if(tag_cache_seen(rx_tag) ||
+               (holdoff_ms && (tag_ready || ui_state == 1) && memcmp(TAG, rx_tag, tag_length) == 0)){
+                tag_repeats++;
+                continue;
+            }
+            memcpy(TAG, rx_tag, tag_length);
+            TAG[tag_length] = '\0';   // Null terminate
+            tag_ready = 1;
+            ui_state = 0;             //a different card cuts the current one short
+            sched_wake(TASK_UI, 0);
+        }
+    }
+    if(tag_pos && (uint16_t)(tick_now() - last_rx) > TAG_GAP_MS) tag_pos = 0;
+    tag_cache_sweep();
 }
 
-void uart_send_string(const char *str){
-    while(*str)
-    uart_send_char(*str++);
+// ---------- ACCESS JOURNAL ----------
+// Each decision goes to the 24C32 journal: ms since boot (the board has no
+// RTC), the packed tag and the verdict. "log <n>" on the console exports
+// every record from sequence n on as TELEM_JOURNAL frames.
+void journal_decision(unsigned char granted){
+    unsigned char d[JOURNAL_DATA];
+    uint32_t t = tick_now32();
+    d[0] = (unsigned char)t;
+    d[1] = (unsigned char)(t >> 8);
+    d[2] = (unsigned char)(t >> 16);
+    d[3] = (unsigned char)(t >> 24);
+    tag_pack(TAG, d + 4);
+    d[10] = granted;
+    journal_add(d);
 }
-//receive character
-char uart_get(){
-      if(OERR){    //overrun error reset
-        CREN = 0;  //TO CLEAR RESET
-        CREN = 1;  // to enable reset
-    }
-    while(!RCIF);
-    return RCREG; //TO SEND    
+
+const char *log_cmd(const char *arg){
+    uint32_t since;
+    if(!console_number(arg, &since)) return "ERR range";
+    journal_export(since);
+    return "OK";
 }
 
-void main(void) {
-    TRISB = 0x00; //CONTROL SIGNALS
-    TRISD = 0x00;
-    
-    char TAG[tag_length + 1];  //+1 for null terminator 
-    const char valid_tag[]= "123412341234"; //authorized ID 
-    int i =0;
-    
-    lcd_init();
-    UART_int();
-    lcd_cmd(0x01); // Clear display
-    
-    
-    lcd_string("UART Initialize"); // r = moves cursor to the beginning of line
-                                             //n = new line
-    __delay_ms(2000);
-    lcd_cmd(0x01); 
-    lcd_string("Scan RF ID....\r\n");
-    
-    while(1){
-        
-        //read 12-byte RFID tag
-        for(i=0;i<tag_length;i++){
-            TAG[i] = uart_get();
-        }
-        TAG[i] = '\0';   // Null terminate
-        
-       // Display on LCD
+//display / compare sequence, one step per release instead of delays
+void ui_task(void){
+    unsigned char i;
+    switch(ui_state){
+    case 0:
+        if(!tag_ready) return;
+        tag_ready = 0;
+        // Display on LCD
         lcd_cmd(0x01); // Clear display
         lcd_string("Tag ID:");
         lcd_cmd(0xC0);
         for(i=0;i<tag_length;i++){ 
             lcd_data(TAG[i]); 
         }
-        __delay_ms(2000);
-        
+        ui_state = 1;
+        sched_wake(TASK_UI, show_id_ms);
+        break;
+    case 1:
         //compare with valid id 
-        
         lcd_cmd(0x01);
         if(strcmp(TAG ,valid_tag) == 0){
             lcd_string("Access Granted");
-            uart_send_string("\r\n Access Granted \r\n ");
+            uart_puts("\r\n Access Granted \r\n ");
+            journal_decision(1);
         } else{
             lcd_string("Access Denied");
-            uart_send_string("\r\n Access Denied");
+            uart_puts("\r\n Access Denied");
+            journal_decision(0);
         }
-       
-        __delay_ms(2000);
-    lcd_cmd(0x01);
-    lcd_string("Next SCAN ID...");
-   }
-}
\ No newline at end of file
+        tag_cache_decided(TAG);
+        ui_state = 2;
+        sched_wake(TASK_UI, verdict_ms);
+        break;
+    case 2:
+        lcd_cmd(0x01);
+        lcd_string("Next SCAN ID...");
+        ui_state = 0;
+        break;
+    default:
+        lcd_cmd(0x01);
+        lcd_string("Scan RF ID....\r\n");
+        ui_state = 0;
+        break;
+    }
+}
+
+sched_task_t tasks[] = {
+    SCHED_TASK(rx_task, 1, 0, 200),
+    SCHED_ONESHOT(ui_task, 5000),
+    SCHED_TASK(console_poll, 5, 2, 300),
+    SCHED_TASK(journal_poll, 1, 0, 300),
+};
+
+const console_var_t settings[] = {
+    CONSOLE_STR("tag", valid_tag, tag_length, tag_length),
+    CONSOLE_U16("show_ms", show_id_ms, 100, 30000),
+    CONSOLE_U16("verdict_ms", verdict_ms, 100, 30000),
+    CONSOLE_U16("holdoff_ms", holdoff_ms, 0, 30000),
+};
+
+const console_stat_t counters[] = {
+    CONSOLE_STAT("tag_repeat", tag_repeats),
+    CONSOLE_STAT("log_drop", journal_dropped),
+    CONSOLE_STAT("rx_drop", uart_rx_dropped),
+    CONSOLE_STAT("rx_over", uart_rx_overruns),
+    CONSOLE_STAT("irq_lost", irq_unhandled),
+};
+
+const console_cmd_t commands[] = {
+    CONSOLE_CMD("log", log_cmd),
+#ifdef IRQ_STATS
+    CONSOLE_CMD("irq", irq_cmd),
+#endif
+};
+
+void main(void) {
+    TRISB = 0x00; //LCD control, spare pins output
+    
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
+    lcd_init();
+    uart_init();
+    console_init(settings, sizeof(settings) / sizeof(settings[0]),
+                 counters, sizeof(counters) / sizeof(counters[0]), 0);
+    console_commands(commands, sizeof(commands) / sizeof(commands[0]));
+    i2c_init();
+    journal_init();
+    tick_init();
+    irq_register(IRQ_TMR2, tick_isr);
+    irq_register(IRQ_RX, uart_rx_isr);
+    irq_register(IRQ_TX, uart_tx_isr);
+    ei();
+    lcd_cmd(0x01); // Clear display
+    
+    
+    lcd_string("UART Initialize");
+    
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
+    sched_wake(TASK_UI, SPLASH_MS);   //cards are read meanwhile; the first cuts it short
+    while(1){
+        sched_run();
+    }
+}
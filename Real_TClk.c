@@ -26,207 +26,129 @@
 #include <xc.h>
 #define _XTAL_FREQ 20000000
 
-// LCD connections
-#define RS RB0
-#define RW RB1
-#define EN RB2
-
-#define LCD PORTD
-
-// LCD Functions
-void lcd_cmd(char cmd) {
-    RS = 0;
-    RW = 0;
-    LCD = cmd;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
+#include "board.h"
+#include "common/sched.h"
+#include "common/fmt.h"
+#include "common/probe.h"
+#include "common/uart.h"
+#include "common/lcd.h"
+#include "common/i2c.h"
+#include "common/ds1307.h"
+#include "common/bcd.h"
+#include "common/irq.h"
+
+#define RTC_PERIOD_MS 200   //RTC poll, the display follows each new second
+#define SPLASH_MS 2000      //title on the LCD before the first time is drawn
+
+// Cycle probes (built with -DPROBES, dumped with 'P' on the USART); ids
+// in board.h
+#ifdef PROBES
+probe_t probes[] = {
+    PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("I2C_start"), PROBE("I2C_stop"),
+    PROBE("I2C_rstart"), PROBE("I2C_write"), PROBE("I2C_read"),
+};
+#endif
+
+// Time and date straight from the DS1307 registers 0-6, BCD
+void RTC_read(unsigned char *sec,unsigned char *min,unsigned char *hrs,
+        unsigned char *date,unsigned char *month,unsigned char *year){
+    unsigned char r[7];    // sec, min, hr, day, date, month, year
+    if(!ds1307_read(DS1307_SEC, r, sizeof(r))) return;
+
+    // Kept in BCD, the display renders the nibbles directly
+    *sec   = r[0] & 0x7F;   // mask CH
+    *min   = r[1];
+    *hrs   = r[2] & 0x3F;
+    *date  = r[4];
+    *month = r[5];
+    *year  = r[6];
 }
+unsigned char sec,min,hrs,date,month,year; //time & date (BCD) from the last RTC read
+unsigned char shown_sec = 0xFF;           //second currently on the LCD
+unsigned char splash = 1;                 //title on the LCD until display_task's first run
 
-void lcd_data(char data) {
-    RS = 1;
-    RW = 0;
-    LCD = data;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
+void rtc_task(void){
+    RTC_read(&sec,&min,&hrs,&date,&month,&year);
 }
 
-void lcd_init() {
-    lcd_cmd(0x38); // 8-bit, 2-line
-    lcd_cmd(0x0C); // display ON
-    lcd_cmd(0x06); // entry mode
-    lcd_cmd(0x01); // clear display
-    __delay_ms(2);
-
+// A DS1307 that lost its backup supply can hold anything, so a time or
+// date that cannot be is shown as dashes rather than rendered digit by digit
+unsigned char rtc_valid(void){
+    return bcd_valid(sec, 0x00, 0x59) && bcd_valid(min, 0x00, 0x59) && bcd_valid(hrs, 0x00, 0x23) &&
+           bcd_valid(year, 0x00, 0x99) && bcd_valid(month, 0x01, 0x12) &&
+           bcd_valid(date, 0x01, bcd_days_in_month(month, year));
 }
 
-void lcd_string(const char *str){
-    while(*str)
-        lcd_data(*str++);
-}
-
-void I2C_wait_idle(void){
-    // Wait until all I2C conditions done and R/W is idle
-    while ((SSPCON2 & 0x1F) || (SSPSTAT & 0x04)); // SEN, RSEN, PEN, RCEN, ACKEN or R/W active
+//redraw only when the second has moved on
+void display_task(void){
+    if(splash){
+        splash = 0;
+        lcd_cmd(0x01);
+    }
+    if(sec == shown_sec) return;
+    shown_sec = sec;
     
-}
-
-void I2C_init(){
-    SSPCON = 0X28; //0010 1000 ENABLE I2C ,MASTER MODE
-    SSPADD = ((_XTAL_FREQ/4)/100000)-1; // BAUD RATE GENERATOR 100khz
-    SSPSTAT = 0x80; //SMP =1  (slew rate disable  STANDARD SPEED)
-    SSPIF =0;
-    TRISC3 = 1;
-    TRISC4 = 1;
-}
-
-void I2C_start(){
-    I2C_wait_idle();
-    SEN =1;        //SEND START CONDITION
-    while(SEN);    //AUTO CLEAR WHEN DONE
-}
-
-void I2C_repeated_start(void){
-    I2C_wait_idle();
-    RSEN = 1;
-    while (RSEN);
-}
-
-void I2C_stop(){
-    I2C_wait_idle();
-    PEN =1;       //STOP CONDITION
-    while(PEN);
-}
-
-
-unsigned char  I2C_write(unsigned char data){
-    I2C_wait_idle();
-    SSPBUF = data ;   //load data into buffer
-    while(!SSPIF);
-    SSPIF = 0;        //ACK received
-    if(SSPCON2bits.ACKSTAT){   //NACK received
-        return 0;          //signal failure
+    char buf[9], *p;
+    
+    if(!rtc_valid()){
+        lcd_cmd(0x80);
+        lcd_string("Time:--:--:--");
+        lcd_cmd(0xC0);
+        lcd_string("Date:--/--/--");
+        return;
     }
-    return 1;              //success
-}    
-
-unsigned char I2C_read(unsigned char ack){
-    I2C_wait_idle();
-    RCEN = 1;           //enable receiver
-    while (!BF);
-    unsigned char data = SSPBUF;  //read it
-    I2C_wait_idle(); 
-    ACKDT = (ack)?0:1; // 0=ACK, 1=NACK
-    ACKEN  = 1;      //send acknowledge
-    while(ACKEN);    //wait for enable complete
-    return data;
+    lcd_cmd(0x80); // 1st row
+    lcd_string("Time:");
+    p = fmt_bcd(buf, hrs);
+    *p++ = ':';
+    p = fmt_bcd(p, min);
+    *p++ = ':';
+    fmt_bcd(p, sec);
+    lcd_string(buf);
+    
+    lcd_cmd(0xC0); //second row
+    lcd_string("Date:");
+    p = fmt_bcd(buf, date);
+    *p++ = '/';
+    p = fmt_bcd(p, month);
+    *p++ = '/';
+    fmt_bcd(p, year);
+    lcd_string(buf);
 }
 
-unsigned char BCD_to_DEC(unsigned char value){
-    return((value>>4)*10 + (value & 0x0F));
-}
+sched_task_t tasks[] = {
+    SCHED_TASK(rtc_task,     RTC_PERIOD_MS, 0,  2000),
+    SCHED_TASK(display_task, RTC_PERIOD_MS, SPLASH_MS, 4000),
+#ifdef PROBES
+    SCHED_TASK(probe_task,   20,            15, 500),
+#endif
+};
 
-//unsigned char DEC_to_BCD(unsigned char value){
-//    return ((value/10) << 4) | (value % 10);
-//}
-
-
-void RTC_start() {
-    unsigned char sec;
-    I2C_start();
-    I2C_write(0xD0);      // Write mode
-    I2C_write(0x00);      // Seconds register
-    I2C_repeated_start();
-    I2C_write(0xD1);      // Read mode
-    sec = I2C_read(0);    // Read seconds
-    I2C_stop();
-
-    // Clear CH (bit7) to start clock
-    sec &= 0x7F;          
-
-    I2C_start();
-    I2C_write(0xD0);      // Write mode
-    I2C_write(0x00);      // Seconds register
-    I2C_write(sec);       // Write updated seconds
-    I2C_stop();
-}
-        
-void RTC_read(unsigned char *sec,unsigned char *min,unsigned char *hrs,
-        unsigned char *date,unsigned char *month,unsigned char *year){
- 
-    I2C_start();
-    I2C_write(0xD0);   //DS1307 0xD0 =address + write mode
-    I2C_write(0x00);   //start from register 00h(seconds)
-    
-    I2C_repeated_start();
-    I2C_write(0xD1);   //DS1307  0xD1 = address + read mode
-    
-    // Registers: 00 sec, 01 min, 02 hr, 03 day, 04 date, 05 month, 06 year
-    unsigned char s  = I2C_read(1);  // ACK, more to come
-    unsigned char m  = I2C_read(1);
-    unsigned char h  = I2C_read(1);
-    I2C_read(1);              // day, discard or store if needed
-    unsigned char dt = I2C_read(1);
-    unsigned char mo = I2C_read(1);
-    unsigned char yr = I2C_read(0);  // NACK last
-    I2C_stop();
-
-    // Convert BCD to DEC
-    *sec   = BCD_to_DEC(s & 0x7F);   // mask CH
-    *min   = BCD_to_DEC(m);
-    *hrs =   BCD_to_DEC(h & 0x3F);
-    *date  = BCD_to_DEC(dt);
-    *month = BCD_to_DEC(mo);
-    *year  = BCD_to_DEC(yr);
-}
 void main(void) {
     
    // Make analog pins digital (important!)
     ADCON1 = 0x07;  // All PORTA/portr analog pins -> digital
     
-    TRISB = 0X00; //CONTROL SIGNALS
-    TRISD = 0X00; //DATA
+    TRISB = 0X00; //LCD control, spare pins output
 
-    unsigned char sec,min,hrs,date,month,year; //variables to hold time & date
-    
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
     lcd_init();
-    I2C_init();
-    RTC_start();
+    i2c_init();
+    ds1307_start();
+    tick_init();
+    irq_register(IRQ_TMR2, tick_isr);
+#ifdef PROBES
+    uart_init();
+    irq_register(IRQ_RX, uart_rx_isr);
+    irq_register(IRQ_TX, uart_tx_isr);
+#endif
+    ei();
     
     lcd_cmd(0x01);
-    lcd_string("DS1307 RTC Demo:");
-    __delay_ms(2000);
-    lcd_cmd(0x01);
+    lcd_string("DS1307 RTC Demo:");   //rtc_task reads on while it shows
    
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
     while(1){
-        RTC_read(&sec,&min,&hrs,&date,&month,&year);
-        
-        lcd_cmd(0x80); // 1st row
-        lcd_string("Time:");
-        
-        lcd_data((hrs/10) + '0');
-        lcd_data((hrs%10) + '0');
-        lcd_data(':');
-        
-        lcd_data((min/10) + '0');
-        lcd_data((min%10) + '0');
-        lcd_data(':');
-        
-        lcd_data((sec/10) + '0');
-        lcd_data((sec%10) + '0');
-        
-        lcd_cmd(0xC0); //second row
-        lcd_string("Date:");
-        
-        lcd_data((date/10) + '0');lcd_data((date%10) + '0');
-        lcd_data('/');
-        
-        lcd_data((month/10) + '0');lcd_data((month%10) + '0');
-        lcd_data('/');
-        
-        lcd_data((year/10) + '0');lcd_data((year%10) + '0');
-        
-        __delay_ms(1000);
+        sched_run();
     }
 }
@@ -22,148 +22,489 @@
 #include <xc.h>
 #define _XTAL_FREQ 20000000
 
-// LCD control pins
-#define RS RB0
-#define RW RB1
-#define EN RB2
-#define LCD PORTD
-
-//Battery Threshold
-#define Full_Volt 138   //13.8v x 10 
+#include "board.h"
+#include "common/tick.h"
+#include "common/uart.h"
+#include "common/telemetry.h"
+#include "common/sched.h"
+#include "common/fmt.h"
+#include "common/probe.h"
+#include "common/lcd.h"
+#include "common/adc.h"
+#include "common/console.h"
+#include "common/bus.h"
+#include "common/irq.h"
+#include "common/soc.h"
+
+//Battery Threshold (Full_Volt can be changed from the console)
+unsigned char Full_Volt = 138;   //13.8v x 10 
 #define Low_Volt 122    //12.2 x 10
-// ---------------- LCD FUNCTIONS ----------------
-void lcd_cmd(unsigned char cmd){
-    LCD = cmd;
-    RS = 0; 
-    RW = 0; 
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
-
-void lcd_data(unsigned char data){
-    LCD = data;
-    RS = 1; 
-    RW = 0; 
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
-
-void lcd_print_string(char *str){
-    while(*str){
-        lcd_data(*str++);
+
+// Set at reset from BUS_JUMPER: answer RS-485 polls (bus.h) instead of
+// running the console and sending telemetry
+unsigned char bus_mode;
+
+// Calibration button (active low, PORTB weak pull-up). Hold it during
+// power-up to run the two-point calibration of all four channels.
+#define CAL_BTN RB4
+#define CAL_LO_VOLT 110   //11.0v reference applied for the first point
+#define CAL_HI_VOLT 140   //14.0v reference applied for the second point
+#define CAL_SAMPLES 16    //ADC samples averaged per calibration point
+
+// Data EEPROM layout
+#define EE_CAL_MAGIC 0x00   //CAL_MAGIC once a calibration has been stored
+#define EE_CAL_BASE  0x01   //4 x {gain lo, gain hi, offset lo, offset hi}
+#define EE_CHARGING  0x11   //charging channel, its complement in the high nibble
+#define CAL_MAGIC    0xC5
+
+// Defaults reproduce the old (adc*50/1023)+100 conversion
+#define CAL_GAIN_DEFAULT   3203  //50/1023 in Q16
+#define CAL_OFFSET_DEFAULT 100   //+10.0v
+
+#define SENSE_PERIOD_MS 500      //battery sampling and relay update (default)
+#define TELEM_PERIOD_MS 1000     //telemetry frame rate on the USART (default)
+#define SPLASH_MS       1000     //title on the LCD while the packs are already sensed
+#define CHARGING_SAVE_MS 600000UL //charging channel unchanged this long before it is saved
+#define SWITCH_PCT      5        //SoC lead a pack needs to take the charger over
+
+// State of charge (soc.h): OCV curve per the chem setting, and the rest a
+// pack needs before its voltage counts as OCV
+unsigned char chem = SOC_FLOODED;
+unsigned int rest_s = 600;
+// Cycle probes (built with -DPROBES, dumped with 'P' on the console); ids
+// in board.h
+#ifdef PROBES
+probe_t probes[] = {
+    PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("adc_read"), PROBE("read_battery"), PROBE("soc"),
+};
+#endif
+
+//Battery Reading Function
+
+// Per-channel calibration in multiply-shift form:
+//   volt = ((adc * cal_gain) >> 16) + cal_offset   (0.1v units)
+// Loaded from EEPROM at boot, so the sample path never divides.
+unsigned int cal_gain[4];
+int cal_offset[4];
+unsigned char cal_valid;         //a calibration was loaded from EEPROM
+unsigned char rail_mask;         //channels whose last reading sat at an ADC rail
+unsigned int pack_mv[4];         //last readings in mV, for the SoC estimate
+
+// 10-bit x 16-bit product. Only the ten ADC bits are walked, so this is
+// ten shift/add steps instead of a 32-bit multiply.
+unsigned long cal_mul(unsigned int adc, unsigned int gain){
+    unsigned long acc = 0;
+    unsigned long g = gain;
+    for(unsigned char i = 0; i < 10; i++){
+        if(adc & 0x01) acc += g;
+        adc >>= 1;
+        g <<= 1;
     }
+    return acc;
 }
 
-void lcd_init(){
-    lcd_cmd(0x38); // 8-bit, 2-line
-    lcd_cmd(0x06); // Increment cursor
-    lcd_cmd(0x0C); // Display on, cursor off
-    lcd_cmd(0x01); // Clear screen
-    __delay_ms(10);
+unsigned int cal_mul_hi(unsigned int adc, unsigned int gain){
+    return (unsigned int)(cal_mul(adc, gain) >> 16);
 }
 
-//Battery Reading Function
+// x * 100 as three shifts and two adds
+unsigned long times_100(unsigned long x){
+    return (x << 6) + (x << 5) + (x << 2);
+}
+
+unsigned char adc_to_volt(unsigned char channel, unsigned int adc_val){
+    int volt = (int)cal_mul_hi(adc_val, cal_gain[channel]) + cal_offset[channel];
+    if(volt < 0) volt = 0;
+    if(volt > 255) volt = 255;   // limit to 25.5v max
+    return (unsigned char)volt;
+}
+
+// Convert with the core asleep (adc_sleep setting) unless a console line
+// may be arriving: the USART's baud clock stops in SLEEP as well. A byte
+// still being shifted in cannot be seen, so the first byte of a command
+// that overlaps a conversion is lost; off unless nothing talks to the
+// board. On the bus a poll can come at any time, so conversions there
+// stay awake.
+unsigned char adc_sleep = 0;
+
+// The same calibration in mV: the product's fraction bits carry on below
+// the 0.1v step, which the SoC curves need
+unsigned int adc_to_mv(unsigned char channel, unsigned int adc_val){
+    long mv = (long)(times_100(cal_mul(adc_val, cal_gain[channel]) >> 8) >> 8);
+    int offset = cal_offset[channel];
+    if(offset < 0) mv -= (long)times_100((unsigned long)-offset);
+    else mv += (long)times_100((unsigned long)offset);
+    if(mv < 0) mv = 0;
+    if(mv > 65535) mv = 65535;
+    return (unsigned int)mv;
+}
+
+unsigned int sample(unsigned char channel){
+    if(adc_sleep && !bus_mode && !uart_rx_ready() && !console_in_line()) return adc_read_sleep(channel);
+    return adc_read(channel);
+}
+
+unsigned char read_battery(unsigned char channel){
+    PROBE_ENTER(P_READ_BATTERY);
+    unsigned int adc = sample(channel);
+    unsigned char bit = 1 << channel;
+    if(adc == 0 || adc >= 1023) rail_mask |= bit;
+    else rail_mask &= ~bit;
+    unsigned char volt = adc_to_volt(channel, adc);
+    pack_mv[channel] = adc_to_mv(channel, adc);
+    PROBE_EXIT(P_READ_BATTERY);
+    return volt;
+}
+
+void cal_load(void){
+    unsigned char valid = (eeprom_read(EE_CAL_MAGIC) == CAL_MAGIC);
+    cal_valid = valid;
+    for(unsigned char ch = 0; ch < 4; ch++){
+        unsigned char addr = EE_CAL_BASE + (ch << 2);
+        if(valid){
+            cal_gain[ch]   = eeprom_read(addr) | (eeprom_read(addr + 1) << 8);
+            cal_offset[ch] = (int)(eeprom_read(addr + 2) | (eeprom_read(addr + 3) << 8));
+        } else {
+            cal_gain[ch]   = CAL_GAIN_DEFAULT;
+            cal_offset[ch] = CAL_OFFSET_DEFAULT;
+        }
+    }
+}
+
+void cal_store(unsigned char ch){
+    unsigned char addr = EE_CAL_BASE + (ch << 2);
+    eeprom_write(addr,     cal_gain[ch] & 0xFF);
+    eeprom_write(addr + 1, cal_gain[ch] >> 8);
+    eeprom_write(addr + 2, (unsigned int)cal_offset[ch] & 0xFF);
+    eeprom_write(addr + 3, (unsigned int)cal_offset[ch] >> 8);
+    eeprom_write(EE_CAL_MAGIC, CAL_MAGIC);
+    cal_valid = 1;
+}
+
+// 0.1v value as "12.5", fixed width so shorter values overwrite old digits
+void lcd_print_tenths(unsigned int v, unsigned char width){
+    char buf[7];
+    fmt_fixed(buf, v, width, 1, ' ');
+    lcd_string(buf);
+}
+
+// Signed 0.1v error, shown as "+0.2"
+void lcd_print_error(int err){
+    if(err < 0){ lcd_data('-'); err = -err; }
+    else lcd_data('+');
+    if(err > 99) err = 99;
+    lcd_print_tenths(err, 3);
+}
+
+// Show the prompt, wait for a CAL_BTN press and return the averaged ADC value
+unsigned int cal_capture(unsigned char channel, unsigned char ref){
+    lcd_cmd(0x01);
+    lcd_string("B");
+    lcd_data('1' + channel);
+    lcd_string(" apply ");
+    lcd_print_tenths(ref, 4);
+    lcd_data('V');
+    lcd_cmd(0xC0);
+    lcd_string("then press CAL");
+
+    while(CAL_BTN);          // wait press
+    __delay_ms(50);
+    while(!CAL_BTN);         // wait release
+    __delay_ms(50);
+
+    unsigned int sum = 0;    // 16 x 1023 still fits 16 bits
+    for(unsigned char i = 0; i < CAL_SAMPLES; i++){
+        sum += adc_read(channel);
+    }
+    return sum / CAL_SAMPLES;  // power of two, compiles to a shift
+}
+
+// Two-point calibration: the only place that divides. Afterwards the
+// residual error at both reference points is shown for each channel.
+void calibrate(void){
+    while(!CAL_BTN);         // let go of the button held at power-up
+    __delay_ms(50);
 
-unsigned int read_battery(unsigned char channel){
+    for(unsigned char ch = 0; ch < 4; ch++){
+        unsigned int lo = cal_capture(ch, CAL_LO_VOLT);
+        unsigned int hi = cal_capture(ch, CAL_HI_VOLT);
+
+        lcd_cmd(0x01);
+        lcd_string("B");
+        lcd_data('1' + ch);
+        if(hi <= lo + (CAL_HI_VOLT - CAL_LO_VOLT)){   // gain would not fit Q16
+            lcd_string(" cal failed");
+            __delay_ms(2000);
+            continue;
+        }
+        cal_gain[ch] = (unsigned int)(((unsigned long)(CAL_HI_VOLT - CAL_LO_VOLT) << 16) / (hi - lo));
+        cal_offset[ch] = CAL_LO_VOLT - (int)cal_mul_hi(lo, cal_gain[ch]);
+        cal_store(ch);
+
+        lcd_string(" error");
+        lcd_cmd(0xC0);
+        lcd_string("L");
+        lcd_print_error((int)adc_to_volt(ch, lo) - CAL_LO_VOLT);
+        lcd_string(" H");
+        lcd_print_error((int)adc_to_volt(ch, hi) - CAL_HI_VOLT);
+        __delay_ms(2000);
+    }
+    lcd_cmd(0x01);
+}
+
+// ---------------- TASKS ----------------
+unsigned char bat[4];            //last readings, 0.1v
+unsigned char charging_bat;      //0 = none, 1-4
+unsigned char charging_saved;    //charging_bat as stored at EE_CHARGING
+unsigned long charging_changed;  //tick_now32() of the last change of charging_bat
+soc_pack_t soc[4];               //state of charge from each pack's last rest
+unsigned char faults;            //BATT_* flags
+unsigned char page;              //display page, 0 = status, 1-4 = voltages
+
+// The driver enable and the bus gap timer ride on the 1 ms tick
+void tick_handler(void){
+    tick_isr();
+    uart_de_poll();
+    bus_tick();
+}
+
+// Charging channel saved before the last reset; 0 (all relays off) for a
+// blank byte or one torn by a brown-out mid-write
+unsigned char charging_load(void){
+    unsigned char v = eeprom_read(EE_CHARGING);
+    if((v >> 4) != (~v & 0x0F) || (v & 0x0F) > 4) return 0;
+    return v & 0x0F;
+}
+
+void relays_set(void){
+    RC0 = (charging_bat == 1);
+    RC1 = (charging_bat == 2);
+    RC2 = (charging_bat == 3);
+    RC3 = (charging_bat == 4);
+}
+
+// TELEM_BATTERY payload
+void battery_status(unsigned char *status){
+    for(unsigned char i = 0; i < 4; i++) status[i] = bat[i];
+    status[4] = charging_bat;
+    status[5] = faults;
+}
+
+// Pack a should charge before pack b: lower state of charge (a pack with
+// no estimate yet counts as empty), then lower voltage. The pack on charge
+// (held, 1-4) keeps it unless the other is SWITCH_PCT lower, so packs that
+// read alike do not trade the relay on a step of ADC noise.
+unsigned char charge_first(unsigned char a, unsigned char b, unsigned char held){
+    unsigned char sa = soc[a].state == SOC_NONE ? 0 : soc[a].pct;
+    unsigned char sb = soc[b].state == SOC_NONE ? 0 : soc[b].pct;
+    if(a + 1 == held) return sb + SWITCH_PCT > sa;
+    if(b + 1 == held) return sa + SWITCH_PCT <= sb;
+    if(sa != sb) return sa < sb;
+    return bat[a] < bat[b];
+}
+
+// Read all packs and switch the relay of the one that needs it most among
+// those below Full_Volt. Terminal voltage under load or charge misranks
+// packs, so they are ranked by the SoC from their last rest; only the
+// full cut-off stays on terminal voltage, and a pack at it counts as full
+// until it has rested, so it is not picked again as its voltage sags back
+// below Full_Volt. On the bus the next poll gets the result.
+void sense_task(void){
+    unsigned long rest_ms = (unsigned long)rest_s * 1000;
+    unsigned long now = tick_now32();
+
+    for(unsigned char i = 0; i < 4; i++){
+        bat[i] = read_battery(i);
+        PROBE_ENTER(P_SOC);
+        soc_update(&soc[i], &soc_curves[chem], pack_mv[i], charging_bat == i + 1, now, rest_ms);
+        if(bat[i] >= Full_Volt) soc_full(&soc[i], now);
+        PROBE_EXIT(P_SOC);
+    }
     
-    ADCON0 = (channel << 2) | 0x01; //select ADC channel bit 2-5((channel - 0,1,2,3 (AN0 - AN03)  and bit 0 - ADON =1 turn ON ADC
-    __delay_ms(10);
-    GO_nDONE = 1;
-    while(GO_nDONE);
+    unsigned char prev = charging_bat;
+    charging_bat = 0;
+    for(unsigned char i = 0; i < 4; i++){
+        if(bat[i] >= Full_Volt) continue;
+        if(!charging_bat || charge_first(i, charging_bat - 1, prev)) charging_bat = i + 1;
+    }
     
-    unsigned int adc_val = ((ADRESH << 8) | ADRESL);
-    unsigned int volt  = (adc_val *50UL /1023) +100; 
-    if(volt > 255) volt = 255;   // limit to 25.5v max
-    //ad_val =   it hold the 10-bit ADC values(0-1023)
-    //50ul (integer math ) - 50 unsigned long (multiplication done in 32-bit ))
-    //1023 divide by max ADC value(1023) to normalize 
-    //+100 is a offset an adjustment to match real battery voltage which adds 10.0v (+100 = 10v)
-    //ADC reads 512 ? (512*50/1023)+100 = 125 ? represents 12.5V
-    return  volt;
+    relays_set();
+    if(charging_bat != prev) charging_changed = now;
+    // The channel is saved once it has held for CHARGING_SAVE_MS, so however
+    // the selection moves the byte takes at most one write per 10 min (144
+    // a day against its 100k cycles); a brown-out sooner than that restores
+    // the channel before, for one sense period. Only between write cycles,
+    // so the task never waits on one (the console's writes included).
+    if(charging_bat != charging_saved && now - charging_changed >= CHARGING_SAVE_MS && !WR){
+        eeprom_write(EE_CHARGING, charging_bat | (unsigned char)(~charging_bat << 4));
+        charging_saved = charging_bat;
+    }
+
+    faults = 0;
+    for(unsigned char i = 0; i < 4; i++){
+        if(bat[i] < Low_Volt) faults |= BATT_LOW;
+    }
+    if(rail_mask) faults |= BATT_SENSE;
+    if(!cal_valid) faults |= BATT_UNCAL;
+
+    if(bus_mode){
+        unsigned char status[6];
+        battery_status(status);
+        bus_status(TELEM_BATTERY, status, sizeof(status));
+    }
+}
+
+void lcd_print_volt(char *label, unsigned char v){
+    lcd_string(label);
+    lcd_print_tenths(v, 4);
+}
+
+// " 81% 75%100% --%": each pack's state of charge, "--" before the first
+void lcd_print_soc(void){
+    char buf[17], *p = buf;
+    for(unsigned char i = 0; i < 4; i++){
+        if(soc[i].state == SOC_NONE){
+            *p++ = ' ';
+            *p++ = '-';
+            *p++ = '-';
+        } else p = fmt_u8(p, soc[i].pct, 3, ' ');
+        *p++ = '%';
+    }
+    *p = '\0';
+    lcd_string(buf);
+}
+
+// "soc": the same, each pack followed by r once the estimate is from a rest
+const char *soc_cmd(const char *arg){
+    static char reply[24];
+    char *p = reply;
+    (void)arg;
+    for(unsigned char i = 0; i < 4; i++){
+        if(soc[i].state == SOC_NONE){
+            *p++ = '-';
+            *p++ = '-';
+        } else p = fmt_u8(p, soc[i].pct, 1, ' ');
+        if(soc[i].state == SOC_RESTED) *p++ = 'r';
+        if(i < 3) *p++ = ' ';
+    }
+    *p = '\0';
+    return reply;
 }
 
+// One second of charging status and SoC, then four seconds of voltages
+void display_task(void){
+    if(page == 0){
+        lcd_cmd(0x01);
+        switch(charging_bat){
+            case 1: lcd_string("Charging B1"); break;
+            case 2: lcd_string("Charging B2"); break;
+            case 3: lcd_string("Charging B3"); break;
+            case 4: lcd_string("Charging B4"); break;
+            default: lcd_string("All 4  Bat Full"); break;
+        }
+        lcd_cmd(0xC0);
+        lcd_print_soc();
+    } else if(page == 1){
+        lcd_cmd(0x01);
+        lcd_print_volt("B1:", bat[0]);
+        lcd_print_volt(" B2:", bat[1]);
+        lcd_cmd(0xC0);
+        lcd_print_volt("B3:", bat[2]);
+        lcd_print_volt(" B4:", bat[3]);
+    }
+    if(++page > 4) page = 0;
+}
+
+void telemetry_task(void){
+    unsigned char status[6];
+    if(bus_mode) return;     //only polls are answered on the bus
+    battery_status(status);
+    telem_send(TELEM_BATTERY, status, sizeof(status));
+}
+
+enum { TASK_SENSE, TASK_TELEM, TASK_DISPLAY, TASK_CONSOLE };
+
+sched_task_t tasks[] = {
+    SCHED_TASK(sense_task,     SENSE_PERIOD_MS, 0,   2000),
+    SCHED_TASK(telemetry_task, TELEM_PERIOD_MS, 50,  1000),
+    SCHED_TASK(display_task,   1000,            SPLASH_MS, 5000),
+    SCHED_TASK(console_task,   5,               10,  300),
+};
+
+// Console settings, saved in data EEPROM above the calibration
+const console_var_t settings[] = {
+    CONSOLE_U8("full_volt", Full_Volt, 100, 160),
+    CONSOLE_U16("sense_ms", tasks[TASK_SENSE].period, 100, 10000),
+    CONSOLE_U16("telem_ms", tasks[TASK_TELEM].period, 100, 30000),
+    CONSOLE_U8("node", telem_node, 0, 255),
+    CONSOLE_U8("adc_sleep", adc_sleep, 0, 1),
+    CONSOLE_U8("chem", chem, 0, SOC_CHEMISTRIES - 1),
+    CONSOLE_U16("rest_s", rest_s, 10, 36000),
+};
+
+const console_stat_t counters[] = {
+    CONSOLE_STAT("telem_drop", telem_dropped),
+    CONSOLE_STAT("rx_drop", uart_rx_dropped),
+    CONSOLE_STAT("rx_over", uart_rx_overruns),
+    CONSOLE_STAT("adc_awake", adc_sleep_missed),
+    CONSOLE_STAT("bus_polls", bus_polls),
+    CONSOLE_STAT("bus_missed", bus_missed),
+    CONSOLE_STAT("bus_crc", bus_crc_errors),
+    CONSOLE_STAT("irq_lost", irq_unhandled),
+};
+
+const console_cmd_t commands[] = {
+    CONSOLE_CMD("soc", soc_cmd),
+#ifdef IRQ_STATS
+    CONSOLE_CMD("irq", irq_cmd),
+#endif
+};
+
+// The relays come back as they were before the reset, latches before TRIS,
+// within microseconds; the packs are read as soon as the LCD is up and
+// the title stays on while sense_task runs
 void main(void) {
+    charging_bat = charging_load();
+    charging_saved = charging_bat;
+    // One byte write: a bit write would read back pins that are still inputs
+    PORTC = charging_bat ? (unsigned char)(1 << (charging_bat - 1)) : 0;
     TRISC = 0XF0;     // For battery
-    TRISB = 0X00;
-    TRISD = 0X00;     //LCD PORT
+    TRISB = 0X30;     //RB4 = CAL button, RB5 = bus jumper, rest output
+    OPTION_REG &= 0x7F; //PORTB weak pull-ups on (nRBPU = 0)
     TRISA = 0XFF;     //AN0 - AN3 AS INPUT
-    ADCON1 = 0X06;    //AN0 - AN3 ANALOG,REST DIGITAL
-    ADCON0 = 0X00;    //ADC OFF INITIALLY
+    adc_init(0x02);   //AN0 - AN4 ANALOG, REST DIGITAL
     
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
     lcd_init();
-    lcd_print_string("Charge Link of 4");
-    __delay_ms(1000);
-    lcd_cmd(0x01);
+    cal_load();
+    if(!CAL_BTN){
+        charging_bat = 0;   //relays off while the inputs carry references
+        relays_set();
+        calibrate();
+    }
+    bus_mode = !BUS_JUMPER;
     
-    while(1){
-        // Read battery voltages
-        unsigned char bat0 = read_battery(0);
-        unsigned char bat1 = read_battery(1);
-        unsigned char bat2 = read_battery(2);
-        unsigned char bat3 = read_battery(3);
-        
-        unsigned char charging_bat = 0;
-        
-        // Determine which battery to charge
-        if(bat0 < Full_Volt && bat0 < bat1 && bat0 < bat2 && bat0 < bat3) 
-            charging_bat = 1;
-        else if(bat1 < Full_Volt && bat1 < bat0 && bat1 < bat2 && bat1 < bat3) 
-            charging_bat = 2;
-        else if(bat2 < Full_Volt && bat2 < bat0 && bat2 < bat1 && bat2 < bat3) 
-            charging_bat = 3;
-        else if(bat3 < Full_Volt && bat3 < bat0 && bat3 < bat1 && bat3 < bat2) 
-            charging_bat = 4;
-        
-        // Switch relays and print charging status on line 1
-        RC0 = RC1 = RC2 = RC3 = 0; // Turn off all relays
-        lcd_cmd(0x80); // Line 1
-        __delay_ms(20);
-        
-        if(charging_bat != 0){
-            switch(charging_bat){
-                case 1: RC0 = 1; lcd_print_string("Charging B1   "); break;
-                case 2: RC1 = 1; lcd_print_string("Charging B2   "); break;
-                case 3: RC2 = 1; lcd_print_string("Charging B3   "); break;
-                case 4: RC3 = 1; lcd_print_string("Charging B4   "); break;
-                __delay_ms(1000);
-            }
-        } else {
-            lcd_print_string("All 4  Bat Full");
-            __delay_ms(500);
-        }
-        
-        // Print battery voltages on line 2
-        
-        lcd_cmd(0x01);
-        lcd_cmd(0x80); // Line 2
-        lcd_print_string("B1:");
-        lcd_data((bat0/10)+'0');
-        lcd_data('.');
-        lcd_data((bat0%10)+'0');
-        
-        
-        lcd_print_string(" B2:");
-        lcd_data((bat1/10)+'0');
-        lcd_data('.');
-        lcd_data((bat1%10)+'0');
-        
+    tick_init();
+    uart_init();
+    console_init(settings, sizeof(settings) / sizeof(settings[0]),
+                 counters, sizeof(counters) / sizeof(counters[0]), 0);
+    console_commands(commands, sizeof(commands) / sizeof(commands[0]));
+    irq_register(IRQ_TMR2, tick_handler);
+    irq_register(IRQ_RX, bus_mode ? bus_rx_isr : uart_rx_isr);
+    irq_register(IRQ_TX, uart_tx_isr);
+    ei();
+    lcd_string("Charge Link of 4");
+    if(bus_mode){
+        char addr[4];
+        fmt_u8(addr, telem_node, 3, ' ');
         lcd_cmd(0xC0);
-        lcd_print_string("B3:");
-        lcd_data((bat2/10)+'0');
-        lcd_data('.');
-        lcd_data((bat2%10)+'0');
-        
-        
-        lcd_print_string(" B4:");
-        lcd_data((bat3/10)+'0');
-        lcd_data('.');
-        lcd_data((bat3%10)+'0');
-        
-        __delay_ms(5000); // Update rate
-        lcd_cmd(0x01);
+        lcd_string("RS485 node ");
+        lcd_string(addr);
+    }
+    
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
+    while(1){
+        sched_run();
     }
     return;
 }
-   
@@ -0,0 +1,41 @@
+/*
+ * File:   board.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// battery_sharing.c: LCD on PORTD/RB0-RB2, packs on AN0-AN3, relays on RC0-RC3,
+// RS-485 transceiver on RC6/RC7 with DE and /RE on RC5.
+// Read by the shared drivers in common/; put boards/battery on the project
+// include path.
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <xc.h>
+
+#ifndef _XTAL_FREQ
+#define _XTAL_FREQ 20000000
+#endif
+
+// LCD
+#define LCD_DATA      PORTD
+#define LCD_DATA_TRIS TRISD
+#define LCD_RS        RB0
+#define LCD_RW        RB1
+#define LCD_EN        RB2
+#define LCD_RS_TRIS   TRISB0
+#define LCD_RW_TRIS   TRISB1
+#define LCD_EN_TRIS   TRISB2
+
+// RS-485 (see bus.h). A jumper from RB5 to ground read at reset puts the
+// board on the bus as a node; without it the USART is the console.
+#define UART_DE       RC5
+#define UART_DE_TRIS  TRISC5
+#define BUS_JUMPER    RB5
+
+// Cycle probe ids, in the order of the firmware's probes[] table
+enum { P_LCD_CMD, P_LCD_DATA, P_ADC_READ, P_READ_BATTERY, P_SOC };
+
+#endif
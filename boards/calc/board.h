@@ -0,0 +1,34 @@
+/*
+ * File:   board.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// mini_calsi.c: LCD on PORTC/RD0-RD2, keypad on PORTB.
+// Read by the shared drivers in common/; put boards/calc on the project
+// include path.
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <xc.h>
+
+#ifndef _XTAL_FREQ
+#define _XTAL_FREQ 20000000
+#endif
+
+// LCD
+#define LCD_DATA      PORTC
+#define LCD_DATA_TRIS TRISC
+#define LCD_RS        RD0
+#define LCD_RW        RD1
+#define LCD_EN        RD2
+#define LCD_RS_TRIS   TRISD0
+#define LCD_RW_TRIS   TRISD1
+#define LCD_EN_TRIS   TRISD2
+
+// Cycle probe ids, in the order of the firmware's probes[] table
+enum { P_LCD_CMD, P_LCD_DATA, P_KEYPAD, P_CALC_KEY, P_CALC_MUL, P_CALC_DIV, P_CALC_FORMAT };
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * File:   board.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// RFID_PIC.c: LCD on PORTD/RB0-RB2, EM-18 on RX, 24C32 journal EEPROM on
+// the MSSP (RC3/RC4).
+// Read by the shared drivers in common/; put boards/rfid on the project
+// include path.
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <xc.h>
+
+#ifndef _XTAL_FREQ
+#define _XTAL_FREQ 20000000
+#endif
+
+// LCD
+#define LCD_DATA      PORTD
+#define LCD_DATA_TRIS TRISD
+#define LCD_RS        RB0
+#define LCD_RW        RB1
+#define LCD_EN        RB2
+#define LCD_RS_TRIS   TRISB0
+#define LCD_RW_TRIS   TRISB1
+#define LCD_EN_TRIS   TRISB2
+
+// USART: the EM-18 only sends at 9600, and the console shares its RX line
+#define UART_BAUD     9600
+
+// Cycle probe ids, in the order of the firmware's probes[] table
+enum {
+    P_LCD_CMD, P_LCD_DATA, P_UART_RX,
+    P_I2C_START, P_I2C_STOP, P_I2C_RSTART, P_I2C_WRITE, P_I2C_READ,
+};
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * File:   board.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// temp_sesnor.c: LCD on PORTD/RC0-RC2, LM35s on AN0 up to AN7 (RE0-RE2 are
+// AN5-AN7), alarm output on RC3.
+// Read by the shared drivers in common/; put boards/temp on the project
+// include path.
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <xc.h>
+
+#ifndef _XTAL_FREQ
+#define _XTAL_FREQ 20000000
+#endif
+
+// LCD
+#define LCD_DATA      PORTD
+#define LCD_DATA_TRIS TRISD
+#define LCD_RS        RC0
+#define LCD_RW        RC1
+#define LCD_EN        RC2
+#define LCD_RS_TRIS   TRISC0
+#define LCD_RW_TRIS   TRISC1
+#define LCD_EN_TRIS   TRISC2
+
+// LM35 channels scanned, from AN0
+#ifndef TEMP_CHANNELS
+#define TEMP_CHANNELS 8
+#endif
+#define ALARM_PIN     RC3      // high while any channel is past a threshold
+
+// Cycle probe ids, in the order of the firmware's probes[] table
+enum { P_LCD_CMD, P_LCD_DATA, P_ADC_READ };
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * File:   adc.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+#include "board.h"
+#include "adc.h"
+#include "probe.h"
+#include "irq.h"
+
+// ADCS2 (ADCON1 bit 6) and ADCS1:0 (ADCON0 bits 7:6)
+#if _XTAL_FREQ <= 1250000
+#define ADC_ADCS2 0x00
+#define ADC_ADCS  0x00     // Fosc/2
+#elif _XTAL_FREQ <= 2500000
+#define ADC_ADCS2 0x40
+#define ADC_ADCS  0x00     // Fosc/4
+#elif _XTAL_FREQ <= 5000000
+#define ADC_ADCS2 0x00
+#define ADC_ADCS  0x40     // Fosc/8
+#elif _XTAL_FREQ <= 10000000
+#define ADC_ADCS2 0x40
+#define ADC_ADCS  0x40     // Fosc/16
+#elif _XTAL_FREQ <= 20000000
+#define ADC_ADCS2 0x00
+#define ADC_ADCS  0x80     // Fosc/32
+#else
+#define ADC_ADCS2 0x40
+#define ADC_ADCS  0x80     // Fosc/64
+#endif
+
+#define ADC_FRC 0xC0       // ADCS1:0 = 11, internal RC clock, ~4 us TAD
+
+uint16_t adc_sleep_missed;
+
+void adc_init(uint8_t pcfg){
+    ADCON1 = 0x80 | ADC_ADCS2 | (pcfg & 0x0F);   // ADFM: right justified
+    ADCON0 = ADC_ADCS | 0x01;                    // ADON, channel 0
+}
+
+uint16_t adc_read(uint8_t channel){
+    PROBE_ENTER(P_ADC_READ);
+    ADCON0 = ADC_ADCS | (uint8_t)(channel << 3) | 0x01;
+    __delay_us(20);        // acquisition after a channel switch or conversion
+    GO_nDONE = 1;
+    while(GO_nDONE);
+    uint16_t adc = ((uint16_t)ADRESH << 8) | ADRESL;
+    PROBE_EXIT(P_ADC_READ);
+    return adc;
+}
+
+// Interrupts stay off across the SLEEP so the wake falls through to the
+// result instead of into the ISR; flags raised meanwhile are served after.
+// Timer1 stops in SLEEP, so with IRQ_STATS the window measured leaves out
+// the conversion itself (12 TAD, about 50 us on the RC clock)
+uint16_t adc_read_sleep(uint8_t channel){
+    IRQ_SAVE;
+
+    if(!TRMT) return adc_read(channel);   // a byte is still being sent
+    PROBE_ENTER(P_ADC_READ);
+    ADCON0 = ADC_FRC | (uint8_t)(channel << 3) | 0x01;
+    __delay_us(20);
+    IRQ_OFF();
+    ADIF = 0;
+    ADIE = 1;
+    PEIE = 1;
+    GO_nDONE = 1;
+    SLEEP();               // GIE is off: no NOP needed for the prefetched instruction
+    if(GO_nDONE){          // SLEEP did not happen: finish awake
+        adc_sleep_missed++;
+        while(GO_nDONE);
+    }
+    ADIE = 0;
+    ADIF = 0;
+    IRQ_ON();
+    uint16_t adc = ((uint16_t)ADRESH << 8) | ADRESL;
+    ADCON0 = ADC_ADCS | (uint8_t)(channel << 3) | 0x01;   // back to the Fosc clock
+    PROBE_EXIT(P_ADC_READ);
+    return adc;
+}
@@ -0,0 +1,37 @@
+/*
+ * File:   adc.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// 10-bit ADC, right justified, Vref = VDD. The conversion clock is picked
+// from _XTAL_FREQ at compile time: the fastest Fosc/n with TAD >= 1.6 us.
+// pcfg is the ADCON1 PCFG3:0 field choosing which pins are analog
+// (0x00 all of AN0-AN7, 0x02 AN0-AN4, see the datasheet table).
+//
+// adc_read_sleep() converts on the ADC's internal RC clock with the core
+// asleep, woken by ADIF: no instruction fetches or port switching while
+// the comparator runs, so less digital noise in the low bits. The price:
+// - Fosc stops for the conversion plus the oscillator start-up, ~0.1 ms
+//   at 20 MHz. The Timer2 tick and the Timer1 fine clock fall behind by
+//   that much.
+// - The USART's baud clock stops too. The call converts awake if a byte
+//   is still being sent. A byte being received across the sleep is
+//   corrupted, so callers use adc_read() while a console line may be
+//   arriving.
+// - An enabled interrupt flag that is already set makes SLEEP a no-op.
+//   The conversion then finishes awake and adc_sleep_missed counts it.
+
+#ifndef ADC_H
+#define ADC_H
+
+#include <stdint.h>
+
+void adc_init(uint8_t pcfg);
+uint16_t adc_read(uint8_t channel);   // selects, waits 20 us acquisition, converts
+uint16_t adc_read_sleep(uint8_t channel);
+
+extern uint16_t adc_sleep_missed;
+
+#endif
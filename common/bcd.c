@@ -0,0 +1,30 @@
+/*
+ * File:   bcd.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 4:00 PM
+ */
+
+#include "bcd.h"
+
+static const uint8_t month_days[12] = {
+    0x31, 0x28, 0x31, 0x30, 0x31, 0x30, 0x31, 0x31, 0x30, 0x31, 0x30, 0x31,
+};
+
+uint8_t bcd_inc(uint8_t v, uint8_t first, uint8_t last){
+    if(v >= last) return first;
+    v++;
+    if((v & 0x0F) == 0x0A) v += 6;   // 0x09 + 1 carries into the tens digit
+    return v;
+}
+
+uint8_t bcd_valid(uint8_t v, uint8_t first, uint8_t last){
+    return (v & 0x0F) <= 9 && (v >> 4) <= 9 && v >= first && v <= last;
+}
+
+// 10 * tens + units is a multiple of 4 when 2 * tens + units is, so only
+// the tens digit's low bit matters
+uint8_t bcd_days_in_month(uint8_t month, uint8_t year){
+    if(month == 0x02 && (((((year >> 4) & 1) << 1) + (year & 0x0F)) & 3) == 0) return 0x29;
+    return month_days[(month < 0x10 ? month : month - 6) - 1];
+}
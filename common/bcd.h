@@ -0,0 +1,28 @@
+/*
+ * File:   bcd.h
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 4:00 PM
+ */
+
+// Packed BCD arithmetic for the DS1307's registers (0x59 is 59), so a
+// clock keeps its time in the chip's own format from the I2C read to the
+// LCD (fmt_bcd) with no binary conversion, and so no division, on the way.
+// Years are 00-99 for 2000-2099, where every fourth year is a leap year.
+
+#ifndef BCD_H
+#define BCD_H
+
+#include <stdint.h>
+
+// v + 1, or first once v has reached last: bcd_inc(0x59, 0x00, 0x59) is 0x00
+uint8_t bcd_inc(uint8_t v, uint8_t first, uint8_t last);
+
+// Both digits 0-9 and first <= v <= last. BCD orders like the number it
+// holds, so plain comparisons work on valid values.
+uint8_t bcd_valid(uint8_t v, uint8_t first, uint8_t last);
+
+// Days in month 0x01-0x12 of year 0x00-0x99, as BCD (0x28-0x31)
+uint8_t bcd_days_in_month(uint8_t month, uint8_t year);
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * File:   bus.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 9:00 AM
+ */
+
+#include <xc.h>
+#include "bus.h"
+#include "crc.h"
+#include "uart.h"
+
+uint16_t bus_polls;
+uint16_t bus_missed;
+uint16_t bus_crc_errors;
+
+static uint8_t reply[2][TELEM_FRAME_LEN(BUS_STATUS_MAX)];
+static uint8_t reply_len[2];
+static volatile uint8_t ready;     // reply[] the interrupt sends
+static volatile uint8_t have;      // a status has been set
+
+static uint8_t rx_pos;             // byte of the frame being heard, 0 = hunting SYNC
+static uint8_t rx_len;             // its full length once LEN is in
+static uint8_t rx_type;
+static uint8_t rx_node;
+static uint8_t rx_crc_lo;          // low CRC byte matched
+static uint16_t rx_crc;
+static uint8_t rx_idle;            // ms since the last byte
+
+void bus_status(uint8_t type, const uint8_t *payload, uint8_t len){
+    uint8_t next = ready ^ 1;
+    if(len > BUS_STATUS_MAX) len = BUS_STATUS_MAX;
+    reply_len[next] = telem_build(reply[next], type, payload, len);
+    have = 1;
+    ready = next;                  // a single byte store: the interrupt sees old or new
+}
+
+static void answer(void){
+    uint8_t r = ready;
+    if(!have || !uart_put_isr(reply[r], reply_len[r])){
+        bus_missed++;
+        return;
+    }
+    bus_polls++;
+}
+
+// crc16_update() for the receive interrupt. The poll's CRC covers the
+// master's sequence and tick, so it cannot be worked out ahead of time, and
+// the main line builds frames with crc16_update(): a copy here keeps the
+// handler from sharing it.
+static uint16_t rx_crc_step(uint16_t crc, uint8_t data){
+    uint8_t x = (uint8_t)(crc >> 8) ^ data;
+    x ^= x >> 4;
+    return (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+}
+
+// Frames for other nodes go past too: they are followed by length so a
+// SYNC value inside a payload is not taken for the start of a poll
+static void rx_byte(uint8_t c){
+    rx_idle = 0;
+    if(rx_pos == 0){
+        if(c == TELEM_SYNC){
+            rx_crc = CRC16_INIT;
+            rx_pos = 1;
+        }
+        return;
+    }
+    if(rx_pos == 1){
+        if(c > TELEM_MAX_PAYLOAD){
+            rx_pos = 0;
+            return;
+        }
+        rx_len = TELEM_FRAME_LEN(c);
+    } else if(rx_pos == 2){
+        rx_type = c;
+    } else if(rx_pos == 3){
+        rx_node = c;
+    }
+    if(rx_pos < rx_len - TELEM_CRC_LEN){
+        rx_crc = rx_crc_step(rx_crc, c);
+    } else if(rx_pos == rx_len - TELEM_CRC_LEN){
+        rx_crc_lo = (c == (uint8_t)rx_crc);
+    } else {
+        rx_pos = 0;
+        if(!rx_crc_lo || c != (uint8_t)(rx_crc >> 8)){
+            bus_crc_errors++;
+            return;
+        }
+        if(rx_type == TELEM_POLL && rx_node == telem_node && telem_node) answer();
+        return;
+    }
+    rx_pos++;
+}
+
+void bus_rx_isr(void){
+    while(RCIF) rx_byte(RCREG);
+    if(OERR){     //overrun stops the receiver until CREN is toggled
+        CREN = 0;
+        CREN = 1;
+        uart_rx_overruns++;
+    }
+}
+
+void bus_tick(void){
+    if(rx_pos && ++rx_idle >= BUS_GAP_MS) rx_pos = 0;
+}
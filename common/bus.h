@@ -0,0 +1,52 @@
+/*
+ * File:   bus.h
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 9:00 AM
+ */
+
+// RS-485 multi-drop node: one master polls, every node only answers.
+// Frames use the telemetry layout (telemetry.h) on a half-duplex bus with
+// the transceiver's DE and /RE tied to UART_DE (board.h):
+//
+//   poll    TELEM_POLL, NODE = address polled, no payload        11 bytes
+//   reply   the status the firmware gave bus_status(), NODE = own address
+//
+// The node's address is telem_node; 0 never answers. The poll is parsed in
+// the receive interrupt (bus_rx_isr() replaces uart_rx_isr()) and the reply
+// queued from there, so it starts within a fraction of a millisecond of the
+// poll's stop bit whatever task is running. The reply is built ahead of
+// time by bus_status() from the main line, double-buffered so a poll never
+// sends half of an update. DE drops within 1 ms of the reply's last stop
+// bit (uart_de_poll() from the tick interrupt).
+//
+// The master leaves BUS_GAP_MS of silence after every slot: by then the
+// node's DE is down, and after a lost or garbled reply it ends the partial
+// frame in every node's parser. A slot per node is so poll + reply +
+// BUS_GAP_MS. Only the interrupt transmits, so nothing else may queue
+// bytes on the USART while the bus is in use. The handler shares no
+// function with the main line (irq.h): it queues with uart_put_isr() and
+// checks the poll's CRC with its own copy of the CRC step.
+
+#ifndef BUS_H
+#define BUS_H
+
+#include <stdint.h>
+#include "telemetry.h"
+
+#ifndef BUS_STATUS_MAX
+#define BUS_STATUS_MAX 8          // longest status payload
+#endif
+#ifndef BUS_GAP_MS
+#define BUS_GAP_MS 3              // silence that ends a partial frame: over two bytes at 9600
+#endif
+
+extern uint16_t bus_polls;        // polls for this node answered
+extern uint16_t bus_missed;       // polls for this node with no status yet or no room to send it
+extern uint16_t bus_crc_errors;   // frames heard with a bad CRC, any address
+
+void bus_status(uint8_t type, const uint8_t *payload, uint8_t len);   // reply to the next poll
+void bus_rx_isr(void);            // from the interrupt handler when RCIE && RCIF
+void bus_tick(void);              // from the interrupt handler after tick_isr()
+
+#endif
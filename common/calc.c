@@ -0,0 +1,197 @@
+/*
+ * File:   calc.c
+ * Author: Rakesh B
+ *
+ * Created on October 24, 2026, 9:00 AM
+ */
+
+#include "calc.h"
+
+#define SIGN_BIT 0x80000000UL
+
+void calc_clear(calc_t *c){
+    c->sum = 0;
+    c->term = 0;
+    c->entry = 0;
+    c->add_op = '+';
+    c->mul_op = 0;
+    c->op = 0;
+    c->digits = 0;
+    c->done = 0;
+    c->error = CALC_OK;
+}
+
+static int32_t add(int32_t a, int32_t b, uint8_t *err){
+    int32_t s = (int32_t)((uint32_t)a + (uint32_t)b);
+    if(((a ^ s) & (b ^ s)) < 0) *err = CALC_OVERFLOW;   // both operands disagree with the sign of s
+    return s;
+}
+
+static int32_t sub(int32_t a, int32_t b, uint8_t *err){
+    int32_t s = (int32_t)((uint32_t)a - (uint32_t)b);
+    if(((a ^ b) & (a ^ s)) < 0) *err = CALC_OVERFLOW;
+    return s;
+}
+
+static uint32_t magnitude(int32_t v){
+    return v < 0 ? 0UL - (uint32_t)v : (uint32_t)v;
+}
+
+// Signed result from a magnitude; -2^31 is the one magnitude above
+// INT32_MAX that still fits
+static int32_t with_sign(uint32_t m, uint8_t neg, uint8_t *err){
+    if(m > (neg ? SIGN_BIT : SIGN_BIT - 1)){
+        *err = CALC_OVERFLOW;
+        return 0;
+    }
+    return neg ? (int32_t)(0UL - m) : (int32_t)m;
+}
+
+// Shift-add over the smaller operand's bits only, so 12 * 34 takes six
+// rounds rather than 32. A bit shifted out of `a` while `b` still has bits
+// left, or a carry out of the sum, is an overflow.
+int32_t calc_mul(int32_t x, int32_t y, uint8_t *err){
+    uint32_t a = magnitude(x), b = magnitude(y), p = 0;
+    uint8_t ovf = 0;
+    if(a < b){
+        uint32_t t = a;
+        a = b;
+        b = t;
+    }
+    while(b){
+        if(b & 1){
+            p += a;
+            if(p < a) ovf = 1;
+        }
+        b >>= 1;
+        if(b && (a & SIGN_BIT)) ovf = 1;
+        a <<= 1;
+    }
+    if(ovf){
+        *err = CALC_OVERFLOW;
+        return 0;
+    }
+    return with_sign(p, (x < 0) != (y < 0), err);
+}
+
+// Restoring shift-subtract division, truncating toward zero like C. Whole
+// zero bytes at the top of the dividend are skipped before the bit loop.
+int32_t calc_div(int32_t x, int32_t y, uint8_t *err){
+    uint32_t n = magnitude(x), d = magnitude(y), q = 0, r = 0;
+    uint8_t bits = 32;
+    if(!d){
+        *err = CALC_DIV0;
+        return 0;
+    }
+    while(bits > 8 && !(n >> 24)){
+        n <<= 8;
+        bits -= 8;
+    }
+    while(bits--){
+        r = (r << 1) | (n >> 31);
+        n <<= 1;
+        q <<= 1;
+        if(r >= d){
+            r -= d;
+            q |= 1;
+        }
+    }
+    return with_sign(q, (x < 0) != (y < 0), err);   // only -2^31 / -1 overflows
+}
+
+// Close the number just typed: fold it into term under the pending * or /,
+// then, unless `op` is itself * or /, fold term into sum
+static void apply(calc_t *c, char op){
+    if(c->mul_op == '*') c->term = calc_mul(c->term, c->entry, &c->error);
+    else if(c->mul_op == '/') c->term = calc_div(c->term, c->entry, &c->error);
+    else c->term = c->entry;
+
+    if(op == '*' || op == '/'){
+        c->mul_op = op;
+    } else {
+        if(c->add_op == '-') c->sum = sub(c->sum, c->term, &c->error);
+        else c->sum = add(c->sum, c->term, &c->error);
+        c->add_op = op;
+        c->mul_op = 0;
+    }
+    c->entry = 0;
+    c->digits = 0;
+}
+
+// Operators are only recorded here and applied when the next number
+// starts, which is what lets a second operator key replace the first
+uint8_t calc_key(calc_t *c, char key){
+    if(key == 'C'){
+        calc_clear(c);
+        return CALC_OK;
+    }
+    if(c->error) return c->error;
+
+    if(key >= '0' && key <= '9'){
+        if(c->done) calc_clear(c);
+        if(c->op){
+            apply(c, c->op);
+            c->op = 0;
+            if(c->error) return c->error;
+        }
+        if(c->digits == CALC_MAX_DIGITS){
+            c->error = CALC_OVERFLOW;
+        } else {
+            c->entry = (c->entry << 3) + (c->entry << 1) + (key - '0');
+            c->digits++;
+        }
+    } else if(key == '=') {
+        if(c->done) return CALC_OK;
+        c->op = 0;                    // "5 + =" drops the dangling +
+        apply(c, '=');
+        c->done = 1;
+    } else if(key == '+' || key == '-' || key == '*' || key == '/') {
+        if(c->done){                  // carry on from the result
+            int32_t v = c->sum;
+            calc_clear(c);
+            c->entry = v;
+        }
+        c->op = key;
+    }
+    return c->error;
+}
+
+int32_t calc_result(const calc_t *c){
+    return c->sum;
+}
+
+char *calc_format(char *dst, int32_t v, uint8_t width){
+    uint32_t m = magnitude(v);
+    uint8_t bcd[5] = { 0, 0, 0, 0, 0 };   // bcd[0] holds the two lowest digits
+    uint8_t bits = 32;
+    while(bits > 8 && !(m >> 24)){          // zero bytes leave the BCD at zero
+        m <<= 8;
+        bits -= 8;
+    }
+    while(bits--){
+        uint8_t carry = (uint8_t)(m >> 31);
+        m <<= 1;
+        for(uint8_t j = 0; j < 5; j++){
+            uint8_t b = bcd[j];
+            if((b & 0x0F) >= 0x05) b += 0x03;
+            if((b & 0xF0) >= 0x50) b += 0x30;
+            bcd[j] = (uint8_t)(b << 1) | carry;
+            carry = b >> 7;
+        }
+    }
+
+    char digits[10];
+    uint8_t n = 0;
+    for(int8_t j = 4; j >= 0; j--){
+        digits[n++] = (char)('0' + (bcd[j] >> 4));
+        digits[n++] = (char)('0' + (bcd[j] & 0x0F));
+    }
+    uint8_t first = 0;
+    while(first < 9 && digits[first] == '0') first++;
+    uint8_t len = (uint8_t)(10 - first) + (v < 0);
+    while(width-- > len) *dst++ = ' ';
+    if(v < 0) *dst++ = '-';
+    while(first < 10) *dst++ = digits[first++];
+    *dst = '\0';
+    return dst;
+}
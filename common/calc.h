@@ -0,0 +1,71 @@
+/*
+ * File:   calc.h
+ * Author: Rakesh B
+ *
+ * Created on October 24, 2026, 9:00 AM
+ */
+
+// Keypad calculator engine: 32-bit signed integers, * and / before + and -,
+// evaluated left to right as the keys arrive. Two registers carry the
+// pending work - `sum` (everything before the last + or -) and `term` (the
+// product/quotient being built) - so no expression stack is needed:
+//
+//   2 + 3 * 4 -   sum = 2, add_op '+', term = 3, mul_op '*', entry = 4
+//                 -> term = 12, sum = 14, add_op '-'
+//
+// Multiply and divide are shift-add/shift-subtract loops over 32 bits; the
+// core has no multiplier and the compiler's library routines do not report
+// overflow. A second operator key replaces the first ("5 + * 2" is 5 * 2).
+//
+// Worst cases. The round counts were measured by running this file on the
+// host with the loops counted; the cycles per round are still hand counts
+// of the byte-wise code XC8 emits for 32-bit shifts, adds and compares
+// (bank selects left out), at 5 MIPS:
+//
+//   calc_mul     46340 * 46340, the largest square that fits: 16 rounds;
+//                INT32_MAX * INT32_MAX overflows after 31. ~58 cycles a
+//                round: ~1050 cycles (210 us) and ~1900 (380 us)
+//   calc_div     INT32_MAX / 1: 32 rounds, ~50 cycles each, ~1700 cycles
+//                (340 us)
+//   calc_format  -2^31: 32 rounds over five BCD bytes, ~120 cycles each,
+//                ~3850 cycles (770 us); 8 rounds for values below 256
+//
+// A PROBES build of mini_calsi.c times exactly these operands once at
+// reset into the calc_mul, calc_div and calc_format probes (read probes[]
+// in the debugger or MPLAB SIM); the host simulator charges nothing for
+// plain C, so only the target gives the cycle figure.
+
+#ifndef CALC_H
+#define CALC_H
+
+#include <stdint.h>
+
+#define CALC_MAX_DIGITS 9          // 999999999 still fits in int32_t
+
+enum { CALC_OK, CALC_OVERFLOW, CALC_DIV0 };
+
+typedef struct {
+    int32_t sum, term, entry;
+    char add_op;                   // '+' or '-' between sum and term
+    char mul_op;                   // '*', '/' or 0 between term and entry
+    char op;                       // operator key waiting for the next number
+    uint8_t digits;                // digits typed into entry
+    uint8_t done;                  // last key was '=': a digit starts over
+    uint8_t error;                 // CALC_OVERFLOW/CALC_DIV0 until cleared
+} calc_t;
+
+void calc_clear(calc_t *c);
+// Feed one key: '0'-'9', '+', '-', '*', '/', '=' or 'C'. Returns the error
+// state; once set, every key but 'C' is ignored.
+uint8_t calc_key(calc_t *c, char key);
+int32_t calc_result(const calc_t *c);     // value after '='
+
+// *err is set to CALC_OVERFLOW/CALC_DIV0 on failure, left alone otherwise
+int32_t calc_mul(int32_t a, int32_t b, uint8_t *err);
+int32_t calc_div(int32_t a, int32_t b, uint8_t *err);
+
+// Signed decimal via a 32-bit double dabble, right-aligned in `width`
+// characters; returns a pointer to the terminator
+char *calc_format(char *dst, int32_t v, uint8_t width);
+
+#endif
@@ -0,0 +1,354 @@
+/*
+ * File:   console.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+#include <xc.h>
+#include <string.h>
+#include "console.h"
+#include "uart.h"
+#include "sched.h"
+#include "tick.h"
+#include "fmt.h"
+#include "probe.h"
+
+#define CONSOLE_MAGIC 0x5C      // plus the firmware's format number
+#define CONSOLE_OUT 48          // longest reply line, CR LF and terminator included
+
+enum { LIST_NONE, LIST_VARS, LIST_TASKS, LIST_STATS };
+
+static const console_var_t *vars;
+static uint8_t var_count;
+static const console_stat_t *stats;
+static uint8_t stat_count;
+static const console_cmd_t *cmds;
+static uint8_t cmd_count;
+
+static char line[CONSOLE_LINE];
+static uint8_t line_len;
+static uint8_t line_long;            // bytes were dropped: the line is answered with ERR
+static uint8_t line_done;            // complete line waiting for console_poll()
+
+uint16_t console_dropped;
+
+static char out[CONSOLE_OUT];        // reply line not yet queued on the USART
+static uint8_t list;                 // multi-line reply in progress
+static uint8_t list_pos;
+
+static uint16_t dirty;               // settings still to be written, bit per table entry
+static uint8_t hdr_left;             // header bytes still to be written
+static uint8_t save_var;
+static uint8_t save_pos;
+static uint8_t save_addr;            // EEPROM address of save_var
+static uint8_t ee_len;               // header plus every setting
+static uint8_t ee_magic;
+
+static uint8_t var_size(const console_var_t *v){
+    if(v->type == CONSOLE_TYPE_U8 || v->type == CONSOLE_TYPE_BCD) return 1;
+    if(v->type == CONSOLE_TYPE_U16) return 2;
+    return (uint8_t)v->max;
+}
+
+static uint8_t var_addr(uint8_t id){
+    uint8_t a = CONSOLE_EE_BASE + 2;
+    for(uint8_t i = 0; i < id; i++) a += var_size(&vars[i]);
+    return a;
+}
+
+// The value in raw (as stored) is acceptable for v
+static uint8_t var_check(const console_var_t *v, const uint8_t *raw){
+    if(v->type == CONSOLE_TYPE_STR){
+        uint8_t n = 0;
+        while(n < v->max && raw[n]){
+            if(raw[n] <= ' ' || raw[n] > '~') return 0;
+            n++;
+        }
+        return n >= v->min;
+    }
+    if(v->type == CONSOLE_TYPE_BCD && ((raw[0] & 0x0F) > 9 || raw[0] > 0x99)) return 0;
+    uint16_t x = raw[0];
+    if(v->type == CONSOLE_TYPE_U16) x |= (uint16_t)raw[1] << 8;
+    return x >= v->min && x <= v->max;
+}
+
+void console_init(const console_var_t *v, uint8_t nvars,
+                  const console_stat_t *s, uint8_t nstats, uint8_t format){
+    vars = v;
+    var_count = nvars;
+    stats = s;
+    stat_count = nstats;
+    ee_len = (uint8_t)(var_addr(nvars) - CONSOLE_EE_BASE);
+    ee_magic = CONSOLE_MAGIC + format;
+
+    if(eeprom_read(CONSOLE_EE_BASE) != ee_magic || eeprom_read(CONSOLE_EE_BASE + 1) != ee_len){
+        dirty = (uint16_t)((1UL << nvars) - 1);
+        hdr_left = 2;
+        return;
+    }
+    uint8_t addr = CONSOLE_EE_BASE + 2;
+    for(uint8_t i = 0; i < nvars; i++){
+        uint8_t raw[CONSOLE_STR_MAX + 1];
+        uint8_t n = var_size(&v[i]);
+        for(uint8_t j = 0; j < n; j++) raw[j] = eeprom_read(addr++);
+        raw[n] = 0;
+        if(var_check(&v[i], raw)) memcpy(v[i].value, raw, v[i].type == CONSOLE_TYPE_STR ? n + 1 : n);
+        else dirty |= (uint16_t)1 << i;
+    }
+}
+
+void console_commands(const console_cmd_t *c, uint8_t ncmds){
+    cmds = c;
+    cmd_count = ncmds;
+}
+
+void console_save(const void *value){
+    for(uint8_t i = 0; i < var_count; i++){
+        if(vars[i].value != value) continue;
+        dirty |= (uint16_t)1 << i;
+        if(save_var == i) save_pos = 0;   // value changed under a write in progress
+    }
+}
+
+// Write the next byte that differs from what the EEPROM holds. Bytes that
+// already match cost a read, not a 4 ms write cycle.
+static void save_poll(void){
+    if(WR) return;
+    while(dirty){
+        uint16_t bit = (uint16_t)1 << save_var;
+        if(dirty & bit){
+            const console_var_t *v = &vars[save_var];
+            if(save_pos == 0) save_addr = var_addr(save_var);
+            if(save_pos < var_size(v)){
+                uint8_t b = ((const uint8_t *)v->value)[save_pos];
+                uint8_t a = save_addr + save_pos++;
+                if(eeprom_read(a) != b){
+                    eeprom_write(a, b);
+                    return;
+                }
+                continue;
+            }
+            dirty &= ~bit;
+        }
+        save_var = (save_var + 1 == var_count) ? 0 : save_var + 1;
+        save_pos = 0;
+    }
+    if(hdr_left){                    // header last, once the layout is all there
+        hdr_left--;
+        eeprom_write(CONSOLE_EE_BASE + hdr_left, hdr_left ? ee_len : ee_magic);
+    }
+}
+
+void console_byte(uint8_t c){
+    if(line_done){                   // previous line not run yet
+        console_dropped++;
+        return;
+    }
+    if(c == '\r' || c == '\n'){
+        if(line_len) line_done = 1;
+        return;
+    }
+    if(c == '\b' || c == 0x7F){
+        if(line_len) line_len--;
+        return;
+    }
+    if(!line_len){
+#ifdef PROBES
+        if(c == PROBE_CMD){
+            probe_dump_start();
+            return;
+        }
+#endif
+        if(c < 'a' || c > 'z') return;   // not the start of a command
+    }
+    if(line_len < CONSOLE_LINE - 1) line[line_len++] = (char)c;
+    else line_long = 1;
+}
+
+uint8_t console_in_line(void){
+    return line_len != 0;
+}
+
+uint8_t console_line_waiting(void){
+    return line_done;
+}
+
+static char *put_str(char *p, const char *s){
+    while(*s) *p++ = *s++;
+    *p = '\0';
+    return p;
+}
+
+static char *put_kv(char *p, const char *name, uint16_t v){
+    p = put_str(p, name);
+    *p++ = '=';
+    return fmt_u16(p, v, 1, ' ');
+}
+
+static void reply(const char *s){
+    put_str(out, s);
+}
+
+static void show_var(const console_var_t *v){
+    char *p = put_str(out, v->name);
+    *p++ = '=';
+    if(v->type == CONSOLE_TYPE_U8) fmt_u8(p, *(uint8_t *)v->value, 1, ' ');
+    else if(v->type == CONSOLE_TYPE_U16) fmt_u16(p, *(uint16_t *)v->value, 1, ' ');
+    else if(v->type == CONSOLE_TYPE_BCD) fmt_bcd(p, *(uint8_t *)v->value);
+    else put_str(p, (const char *)v->value);
+}
+
+// Timer1 counts to us (x 1.6), saturating at 65535
+static void show_task(uint8_t id){
+    const sched_task_t *t = &sched_tasks[id];
+    char *p = out;
+    *p++ = 't';
+    p = fmt_u8(p, id, 1, ' ');
+    p = put_kv(p, " n", t->runs);
+    p = put_kv(p, " over", t->overruns);
+    p = put_kv(p, " skip", t->skipped);
+    p = put_kv(p, " late", t->late_max);
+    p = put_kv(p, " max", tick_fine_us(t->time_max));
+    put_str(p, "us");
+}
+
+static const console_var_t *find_var(const char *name){
+    for(uint8_t i = 0; i < var_count; i++){
+        if(strcmp(vars[i].name, name) == 0) return &vars[i];
+    }
+    return 0;
+}
+
+uint8_t console_number(const char *s, uint32_t *v){
+    uint32_t x = 0;
+    if(!*s) return 0;
+    while(*s){
+        if(*s < '0' || *s > '9' || x > 429496728UL) return 0;   // x * 10 + 9 must fit
+        x = (x << 3) + (x << 1) + (uint8_t)(*s++ - '0');
+    }
+    *v = x;
+    return 1;
+}
+
+static const char *set_var(const console_var_t *v, const char *arg){
+    if(v->type == CONSOLE_TYPE_STR){
+        uint8_t raw[CONSOLE_STR_MAX + 1];
+        uint8_t n = 0;
+        while(arg[n] && n <= v->max){
+            raw[n] = (uint8_t)arg[n];
+            n++;
+        }
+        if(n > v->max) return "ERR range";
+        memset(raw + n, 0, sizeof(raw) - n);
+        if(!var_check(v, raw)) return "ERR range";
+        memcpy(v->value, raw, v->max + 1);
+    } else if(v->type == CONSOLE_TYPE_BCD){
+        uint8_t b = 0;                   // one or two digits, packed as typed
+        if(!arg[0] || (arg[1] && arg[2])) return "ERR range";
+        for(; *arg; arg++){
+            if(*arg < '0' || *arg > '9') return "ERR range";
+            b = (uint8_t)(b << 4) | (uint8_t)(*arg - '0');
+        }
+        if(!var_check(v, &b)) return "ERR range";
+        *(uint8_t *)v->value = b;
+    } else {
+        uint32_t x;
+        if(!console_number(arg, &x) || x < v->min || x > v->max) return "ERR range";
+        if(v->type == CONSOLE_TYPE_U8) *(uint8_t *)v->value = (uint8_t)x;
+        else *(uint16_t *)v->value = x;
+    }
+    console_save(v->value);
+    return "OK";
+}
+
+// Split the line in place into at most three words
+static void run_line(void){
+    char *w[3] = { 0, 0, 0 };
+    uint8_t n = 0;
+    line[line_len] = '\0';
+    for(char *p = line; *p && n < 3; ){
+        while(*p == ' ') *p++ = '\0';
+        if(!*p) break;
+        w[n++] = p;
+        while(*p && *p != ' ') p++;
+    }
+
+    if(line_long){
+        reply("ERR ?");
+    } else if(strcmp(w[0], "get") == 0){
+        if(!w[1]){
+            list = LIST_VARS;
+            list_pos = 0;
+        } else {
+            const console_var_t *v = find_var(w[1]);
+            if(v) show_var(v);
+            else reply("ERR name");
+        }
+    } else if(strcmp(w[0], "set") == 0 && w[2]){
+        const console_var_t *v = find_var(w[1]);
+        reply(v ? set_var(v, w[2]) : "ERR name");
+    } else if(strcmp(w[0], "stats") == 0){
+        list = LIST_TASKS;
+        list_pos = 0;
+    } else {
+        uint8_t i = 0;
+        while(i < cmd_count && strcmp(cmds[i].name, w[0]) != 0) i++;
+        reply(i < cmd_count ? cmds[i].fn(w[1] ? w[1] : "") : "ERR ?");
+    }
+    line_len = 0;
+    line_long = 0;
+    line_done = 0;
+}
+
+// Next line of a get/stats listing into out[]
+static void list_next(void){
+    if(list == LIST_VARS){
+        if(list_pos < var_count){
+            show_var(&vars[list_pos++]);
+            return;
+        }
+    } else if(list == LIST_TASKS){
+        if(list_pos < sched_count){
+            show_task(list_pos++);
+            return;
+        }
+        list = LIST_STATS;
+        list_pos = 0;
+    }
+    if(list == LIST_STATS && list_pos < stat_count){
+        put_kv(out, stats[list_pos].name, *stats[list_pos].value);
+        list_pos++;
+        return;
+    }
+    if(list == LIST_STATS && list_pos == stat_count){
+        put_kv(out, "con_drop", console_dropped);
+        list_pos++;
+        return;
+    }
+    list = LIST_NONE;
+}
+
+// One step per call: an EEPROM byte, a reply line or a command
+void console_poll(void){
+    save_poll();
+
+    if(out[0]){
+        uint8_t n = (uint8_t)strlen(out);
+        if(n + 2 > uart_tx_room()) return;
+        for(uint8_t i = 0; i < n; i++) uart_put(out[i]);
+        uart_put('\r');
+        uart_put('\n');
+        out[0] = '\0';
+    } else if(list){
+        list_next();
+    } else if(line_done){
+        run_line();
+    }
+    probe_poll();
+}
+
+void console_task(void){
+    while(!line_done && uart_rx_ready()) console_byte(uart_rx());
+    console_poll();
+}
@@ -0,0 +1,113 @@
+/*
+ * File:   console.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// Line-oriented command console on the USART for settings that used to
+// need a reflash. Lines end in CR or LF; commands start with a lowercase
+// letter and replies are single lines ending in CR LF:
+//
+//   get                  every setting, one "name=value" line each
+//   get <name>           name=value
+//   set <name> <value>   OK, or ERR name / ERR range / ERR ?
+//   stats                per-task scheduler statistics ("t<id> ..."), then
+//                        the firmware's counters as name=value, then
+//                        con_drop (bytes console_byte() had to discard)
+//
+// plus any commands the firmware registers with console_commands().
+//
+// Received bytes are only appended to the line buffer; a complete line is
+// executed on a later console_poll() call, and every call after that emits
+// at most one reply line or writes one EEPROM byte, so no call waits on the
+// USART or an EEPROM write cycle. With PROBES, a PROBE_CMD byte at the start
+// of a line starts a probe dump as before.
+//
+// While a complete line waits to run, console_byte() has nowhere to put a
+// byte and discards it (counted in console_dropped). Firmware that feeds
+// it stops reading the USART while console_line_waiting() is set, so the
+// bytes wait in the receive ring instead; on a shared RX (the RFID reader)
+// they may be the next tag, not the console's.
+//
+// The firmware owns the tables:
+//
+//   const console_var_t settings[] = {
+//       CONSOLE_U8("full_volt", Full_Volt, 100, 160),
+//       CONSOLE_BCD("alarm_hr", alarm_hr, 0x00, 0x23),
+//       CONSOLE_U16("sense_ms", tasks[TASK_SENSE].period, 100, 10000),
+//       CONSOLE_STR("tag", valid_tag, 12, 12),
+//   };
+//   const console_stat_t counters[] = { CONSOLE_STAT("rx_drop", uart_rx_dropped) };
+//   ...
+//   console_init(settings, 3, counters, 1, 0);   // loads saved values
+//
+// Settings are saved in data EEPROM from CONSOLE_EE_BASE: a magic byte and
+// the layout length, then each variable in table order (U8 and BCD one
+// byte, U16 two, STR max bytes). A saved value that is out of range, or a
+// header that does not match the table, leaves the initializer's default
+// in place and rewrites it. The magic byte includes the format number the
+// firmware passes to console_init(): a firmware bumps its own number when
+// the stored form of one of its settings changes, so what older firmware
+// saved reads as absent, not as different values, and boards whose layout
+// did not change keep their settings. Keep the layout clear of other EEPROM users (eelog,
+// calibration) and of the end of the EEPROM.
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+
+#ifndef CONSOLE_EE_BASE
+#define CONSOLE_EE_BASE 0xE0    // 32 bytes above the eelog ring
+#endif
+#define CONSOLE_LINE 28         // longest command line, terminator included
+#define CONSOLE_STR_MAX 16      // longest CONSOLE_STR setting
+#define CONSOLE_MAX_VARS 16
+
+enum { CONSOLE_TYPE_U8, CONSOLE_TYPE_U16, CONSOLE_TYPE_STR, CONSOLE_TYPE_BCD };
+
+typedef struct {
+    const char *name;
+    void *value;
+    uint8_t type;
+    uint16_t min;               // STR: shortest and longest length
+    uint16_t max;
+} console_var_t;
+
+typedef struct {
+    const char *name;
+    const volatile uint16_t *value;
+} console_stat_t;
+
+#define CONSOLE_U8(name, var, min, max)  { name, &(var), CONSOLE_TYPE_U8, min, max }
+#define CONSOLE_U16(name, var, min, max) { name, &(var), CONSOLE_TYPE_U16, min, max }
+#define CONSOLE_STR(name, buf, min, max) { name, buf, CONSOLE_TYPE_STR, min, max }   // buf holds max + 1
+#define CONSOLE_BCD(name, var, min, max) { name, &(var), CONSOLE_TYPE_BCD, min, max }  // two-digit packed BCD, shown and set in decimal
+typedef struct {
+    const char *name;
+    const char *(*fn)(const char *arg);   // arg is "" when missing; returns the reply line
+} console_cmd_t;
+
+#define CONSOLE_STAT(name, var) { name, &(var) }
+#define CONSOLE_CMD(name, fn) { name, fn }
+
+void console_init(const console_var_t *vars, uint8_t nvars,
+                  const console_stat_t *stats, uint8_t nstats, uint8_t format);
+void console_commands(const console_cmd_t *cmds, uint8_t ncmds);
+
+void console_byte(uint8_t c);       // one received byte
+uint8_t console_in_line(void);      // a line is being collected or waits to run
+uint8_t console_line_waiting(void); // a complete line waits to run: leave RX alone
+void console_poll(void);            // call from a periodic task
+void console_task(void);            // takes received bytes from the USART, then polls
+
+extern uint16_t console_dropped;    // bytes discarded while a line waited
+
+// Save a setting the firmware changed itself (e.g. from the buttons)
+void console_save(const void *value);
+
+// Unsigned decimal that fits 32 bits; 0 if s is anything else
+uint8_t console_number(const char *s, uint32_t *v);
+
+#endif
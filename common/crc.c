@@ -0,0 +1,25 @@
+/*
+ * File:   crc.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:05 AM
+ */
+
+#include "crc.h"
+
+// Table-free CCITT step: a handful of shifts and XORs per byte instead of
+// eight loop iterations, and no 512-byte table in program memory.
+uint16_t crc16_update(uint16_t crc, uint8_t data){
+    uint8_t x = (uint8_t)(crc >> 8) ^ data;
+    x ^= x >> 4;
+    return (uint16_t)((crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x);
+}
+
+uint16_t crc16(const uint8_t *buf, uint8_t len){
+    uint16_t crc = CRC16_INIT;
+    while(len--){
+        crc = crc16_update(crc, *buf++);
+    }
+    return crc;
+}
+
@@ -0,0 +1,21 @@
+/*
+ * File:   crc.h
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:05 AM
+ */
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+// Plain C with no device headers, so the host tools build the same file.
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+#define CRC16_INIT 0xFFFF
+
+uint16_t crc16_update(uint16_t crc, uint8_t data);
+uint16_t crc16(const uint8_t *buf, uint8_t len);
+
+#endif
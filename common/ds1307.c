@@ -0,0 +1,45 @@
+/*
+ * File:   ds1307.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+#include "ds1307.h"
+#include "i2c.h"
+
+#define DS1307_W 0xD0
+#define DS1307_R 0xD1
+
+uint8_t ds1307_read(uint8_t reg, uint8_t *buf, uint8_t n){
+    i2c_start();
+    uint8_t ok = i2c_write(DS1307_W) && i2c_write(reg);
+    if(ok){
+        i2c_rstart();
+        ok = i2c_write(DS1307_R);
+        while(ok && n){
+            n--;
+            *buf++ = i2c_read(n != 0);     // NACK the last byte
+        }
+    }
+    i2c_stop();
+    return ok;
+}
+
+uint8_t ds1307_write(uint8_t reg, const uint8_t *buf, uint8_t n){
+    i2c_start();
+    uint8_t ok = i2c_write(DS1307_W) && i2c_write(reg);
+    while(ok && n--){
+        ok = i2c_write(*buf++);
+    }
+    i2c_stop();
+    return ok;
+}
+
+void ds1307_start(void){
+    uint8_t sec;
+    if(ds1307_read(DS1307_SEC, &sec, 1) && (sec & DS1307_CH)){
+        sec &= ~DS1307_CH;
+        ds1307_write(DS1307_SEC, &sec, 1);
+    }
+}
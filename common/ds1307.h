@@ -0,0 +1,30 @@
+/*
+ * File:   ds1307.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// DS1307 RTC over common/i2c. Registers are BCD:
+//   0 seconds (bit 7 = CH, clock halt)  1 minutes  2 hours (bit 6 = 12h)
+//   3 day  4 date  5 month  6 year  7 control  8-0x3F NVRAM
+// The register pointer auto-increments, so one call moves a whole block.
+
+#ifndef DS1307_H
+#define DS1307_H
+
+#include <stdint.h>
+
+#define DS1307_SEC   0x00
+#define DS1307_MIN   0x01
+#define DS1307_HOUR  0x02
+#define DS1307_DATE  0x04
+#define DS1307_CH    0x80
+
+uint8_t ds1307_read(uint8_t reg, uint8_t *buf, uint8_t n);         // 0 if no ACK
+uint8_t ds1307_write(uint8_t reg, const uint8_t *buf, uint8_t n);
+
+// Clears CH, keeping the seconds: a new chip powers up halted
+void ds1307_start(void);
+
+#endif
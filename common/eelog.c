@@ -0,0 +1,154 @@
+/*
+ * File:   eelog.c
+ * Author: Rakesh B
+ *
+ * Created on October 20, 2026, 9:30 AM
+ */
+
+#include <xc.h>
+#include "eelog.h"
+#include "telemetry.h"
+#include "uart.h"
+
+#define SEQ_ERASED 0xFF
+#define SEQ_NEXT(s) ((s) == 254 ? 0 : (s) + 1)
+
+static uint8_t fill[EELOG_PAGE];     // page being filled in RAM
+static uint8_t fill_pos;             // next free byte in fill[]
+static int16_t fill_prev;
+
+static uint8_t flush[EELOG_PAGE];    // sealed page being written out
+static uint8_t flush_pos;            // EEPROM writes left, 0 = idle (see eelog_poll)
+static uint8_t wr_page;              // ring slot the next sealed page goes to
+static uint8_t wr_seq;
+
+static uint8_t dump_left;            // ring slots still to stream, +1 for the RAM page
+static uint8_t dump_page;
+static uint8_t dump_kind;
+static uint8_t dump_inflight;        // the last slot was being written when the dump began
+
+uint16_t eelog_dropped;
+
+#define PAGE_ADDR(p) (EELOG_BASE + (p) * EELOG_PAGE)
+#define NEXT_PAGE(p) ((p) + 1 == EELOG_PAGES ? 0 : (p) + 1)
+
+// Find the newest page: the valid page whose successor does not carry the
+// next sequence number. Writing resumes in the slot after it.
+void eelog_init(void){
+    uint8_t newest = 0xFF;
+    for(uint8_t p = 0; p < EELOG_PAGES; p++){
+        uint8_t s = eeprom_read(PAGE_ADDR(p));
+        if(s == SEQ_ERASED) continue;
+        if(eeprom_read(PAGE_ADDR(NEXT_PAGE(p))) != SEQ_NEXT(s)){
+            newest = p;
+            wr_seq = SEQ_NEXT(s);
+            break;
+        }
+    }
+    wr_page = (newest == 0xFF) ? 0 : NEXT_PAGE(newest);
+    fill_pos = 0;
+}
+
+static uint8_t varint_len(uint16_t z){
+    if(z < 0x80) return 1;
+    if(z < 0x4000) return 2;
+    return 3;
+}
+
+static void seal_page(void){
+    if(flush_pos){
+        eelog_dropped += fill[1];    // previous page still going out
+    } else {
+        for(uint8_t i = 1; i < EELOG_PAGE; i++){
+            flush[i] = (i < fill_pos) ? fill[i] : 0;
+        }
+        flush[0] = wr_seq;
+        flush_pos = EELOG_PAGE + 1;
+    }
+    fill_pos = 0;
+}
+
+void eelog_add(int16_t v){
+    if(fill_pos){
+        int16_t d = v - fill_prev;
+        uint16_t z = ((uint16_t)d << 1) ^ (uint16_t)(d >> 15);   // zigzag
+        if(fill_pos + varint_len(z) <= EELOG_PAGE){
+            while(z >= 0x80){
+                fill[fill_pos++] = (uint8_t)z | 0x80;
+                z >>= 7;
+            }
+            fill[fill_pos++] = (uint8_t)z;
+            fill[1]++;
+            fill_prev = v;
+            return;
+        }
+        seal_page();
+    }
+    fill[1] = 1;
+    fill[2] = (uint8_t)v;
+    fill[3] = (uint8_t)((uint16_t)v >> 8);
+    fill_pos = 4;
+    fill_prev = v;
+}
+
+static void send_page(const uint8_t *page, uint8_t used){
+    uint8_t frame[1 + EELOG_PAGE];
+    frame[0] = dump_kind;
+    for(uint8_t i = 0; i < EELOG_PAGE; i++){
+        frame[1 + i] = (i < used) ? page[i] : 0;
+    }
+    telem_send(TELEM_LOG, frame, sizeof(frame));
+}
+
+// One page per call, whenever the UART ring can take a whole frame
+static void dump_poll(void){
+    if(dump_left == 1){
+        if(fill_pos){
+            fill[0] = SEQ_ERASED;            // marks the unsaved RAM page
+            send_page(fill, fill_pos);
+        }
+    } else if(dump_left == 2 && dump_inflight && flush_pos){
+        send_page(flush, EELOG_PAGE);        // still being written
+    } else {
+        uint8_t page[EELOG_PAGE];
+        uint8_t addr = PAGE_ADDR(dump_page);
+        for(uint8_t i = 0; i < EELOG_PAGE; i++){
+            page[i] = eeprom_read(addr + i);
+        }
+        if(page[0] != SEQ_ERASED) send_page(page, EELOG_PAGE);
+        dump_page = NEXT_PAGE(dump_page);
+    }
+    dump_left--;
+}
+
+void eelog_poll(void){
+    // One EEPROM byte per call, only once the previous write cycle is done.
+    // The sequence byte is erased first and written last, so a page cut
+    // short by a reset reads as erased instead of half old, half new.
+    if(flush_pos && !WR){
+        uint8_t addr = PAGE_ADDR(wr_page);
+        if(flush_pos == EELOG_PAGE + 1){
+            eeprom_write(addr, SEQ_ERASED);
+        } else if(flush_pos > 1){
+            uint8_t i = EELOG_PAGE + 1 - flush_pos;   // 1 .. EELOG_PAGE-1
+            eeprom_write(addr + i, flush[i]);
+        } else {
+            eeprom_write(addr, flush[0]);
+            wr_page = NEXT_PAGE(wr_page);
+            wr_seq = SEQ_NEXT(wr_seq);
+        }
+        flush_pos--;
+    }
+    // As many frames as the transmit ring has room for, so a fast link is
+    // not held to one frame per call
+    while(dump_left && uart_tx_room() >= TELEM_FRAME_LEN(1 + EELOG_PAGE)) dump_poll();
+}
+
+// Oldest first: the slot being overwritten is the newest page, so a dump
+// that starts mid-flush begins one slot later and ends on that slot.
+void eelog_dump_start(uint8_t kind){
+    dump_kind = kind;
+    dump_inflight = (flush_pos != 0);
+    dump_page = dump_inflight ? NEXT_PAGE(wr_page) : wr_page;
+    dump_left = EELOG_PAGES + 1;
+}
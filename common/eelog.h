@@ -0,0 +1,45 @@
+/*
+ * File:   eelog.h
+ * Author: Rakesh B
+ *
+ * Created on October 20, 2026, 9:30 AM
+ */
+
+// Sample log in a ring of pages in the internal data EEPROM.
+//
+// Page layout (EELOG_PAGE bytes):
+//   0     sequence number 0-254, 0xFF = erased / being written
+//   1     sample count
+//   2..3  first sample, int16 little endian
+//   4..   zigzag varint deltas to the previous sample (1 byte for |d| < 64)
+//
+// Samples collect in a RAM page; the EEPROM is only written when that page
+// is full, one byte per eelog_poll() so the caller never waits on a write
+// cycle. The oldest page is reused next, which spreads wear over the ring.
+// Samples still in RAM are lost on power-down.
+
+#ifndef EELOG_H
+#define EELOG_H
+
+#include <stdint.h>
+
+#define EELOG_PAGE 16
+
+#ifndef EELOG_BASE
+#define EELOG_BASE 0x00
+#endif
+#ifndef EELOG_PAGES
+#define EELOG_PAGES 14      // 0x00-0xDF, top of EEPROM left for settings
+#endif
+
+void eelog_init(void);
+void eelog_add(int16_t v);
+void eelog_poll(void);
+
+// Stream every stored page, oldest first, then the page still in RAM, as
+// TELEM_LOG frames. kind is the TELEM_* type describing the sample values.
+void eelog_dump_start(uint8_t kind);
+
+extern uint16_t eelog_dropped;   // samples lost while a page was still flushing
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * File:   fmt.c
+ * Author: Rakesh B
+ *
+ * Created on October 21, 2026, 10:00 AM
+ */
+
+#include "fmt.h"
+
+#define FMT_DIGITS 5
+
+// Unpacked digits, most significant first, via double dabble: shift the
+// value into a BCD accumulator, adding 3 to every nibble >= 5 before each
+// shift. Three bytes hold the five digits of 65535.
+static void bin_to_digits(uint16_t v, uint8_t d[FMT_DIGITS]){
+    uint8_t b0 = 0, b1 = 0, b2 = 0;   // units|tens, hundreds|thousands, ten-thousands
+
+    for(uint8_t i = 0; i < 16; i++){
+        if((b0 & 0x0F) >= 0x05) b0 += 0x03;
+        if((b0 & 0xF0) >= 0x50) b0 += 0x30;
+        if((b1 & 0x0F) >= 0x05) b1 += 0x03;
+        if((b1 & 0xF0) >= 0x50) b1 += 0x30;
+        if((b2 & 0x0F) >= 0x05) b2 += 0x03;
+        b2 = (uint8_t)(b2 << 1) | (b1 >> 7);
+        b1 = (uint8_t)(b1 << 1) | (b0 >> 7);
+        b0 = (uint8_t)(b0 << 1) | (uint8_t)(v >> 15);
+        v <<= 1;
+    }
+    d[0] = b2;
+    d[1] = b1 >> 4;
+    d[2] = b1 & 0x0F;
+    d[3] = b0 >> 4;
+    d[4] = b0 & 0x0F;
+}
+
+// Emit the last `width` digits (more if significant), padding leading
+// zeros. min_digits forces zeros the pad must not hide, e.g. "0.05".
+static char *put_digits(char *dst, const uint8_t *d, uint8_t width, uint8_t min_digits, char pad){
+    uint8_t first = 0;
+    while(first < FMT_DIGITS - 1 && d[first] == 0) first++;   // first significant
+    if(first > FMT_DIGITS - min_digits) first = FMT_DIGITS - min_digits;
+
+    uint8_t start = (width < FMT_DIGITS) ? FMT_DIGITS - width : 0;
+    if(start > first) start = first;
+    for(uint8_t i = start; i < FMT_DIGITS; i++){
+        *dst++ = (i < first) ? pad : (char)('0' + d[i]);
+    }
+    *dst = '\0';
+    return dst;
+}
+
+char *fmt_u16(char *dst, uint16_t v, uint8_t width, char pad){
+    uint8_t d[FMT_DIGITS];
+    bin_to_digits(v, d);
+    return put_digits(dst, d, width, 1, pad);
+}
+
+// 8-bit path: tens = v * 205 >> 11 and hundreds = v * 41 >> 12 are exact
+// for 0-255, one 8x8 multiply each instead of a division routine.
+char *fmt_u8(char *dst, uint8_t v, uint8_t width, char pad){
+    uint8_t d[FMT_DIGITS];
+    uint8_t h = (uint8_t)(((uint16_t)v * 41) >> 12);
+    uint8_t rest = v - h * 100;
+    uint8_t t = (uint8_t)(((uint16_t)rest * 205) >> 11);
+    d[0] = 0;
+    d[1] = 0;
+    d[2] = h;
+    d[3] = t;
+    d[4] = rest - t * 10;
+    return put_digits(dst, d, width, 1, pad);
+}
+
+char *fmt_fixed(char *dst, uint16_t v, uint8_t width, uint8_t decimals, char pad){
+    uint8_t d[FMT_DIGITS];
+    bin_to_digits(v, d);
+    // digits left of the point get the width minus point and decimals
+    uint8_t int_width = (width > decimals + 1) ? width - decimals - 1 : 1;
+    dst = put_digits(dst, d, int_width + decimals, decimals + 1, pad);
+    // open a gap for the point in front of the last `decimals` digits
+    for(uint8_t i = 0; i <= decimals; i++){
+        dst[1 - i] = dst[-i];
+    }
+    dst[-decimals] = '.';
+    return dst + 1;
+}
+
+char *fmt_bcd(char *dst, uint8_t bcd){
+    *dst++ = '0' + (bcd >> 4);
+    *dst++ = '0' + (bcd & 0x0F);
+    *dst = '\0';
+    return dst;
+}
@@ -0,0 +1,32 @@
+/*
+ * File:   fmt.h
+ * Author: Rakesh B
+ *
+ * Created on October 21, 2026, 10:00 AM
+ */
+
+// Fixed-width decimal formatting without division: 8-bit values use a
+// reciprocal multiply, 16-bit values a double-dabble shift. Packed BCD
+// (DS1307 registers) is rendered straight from its nibbles.
+//
+// Every call writes into dst, NUL-terminates and returns a pointer to the
+// terminator, so calls chain: p = fmt_u8(p, h, 2, '0'); *p++ = ':'; ...
+// width is a minimum (at most 5 digits); a value with more digits is never
+// truncated.
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdint.h>
+
+char *fmt_u8(char *dst, uint8_t v, uint8_t width, char pad);
+char *fmt_u16(char *dst, uint16_t v, uint8_t width, char pad);
+
+// v scaled by 10^decimals: fmt_fixed(p, 125, 4, 1, ' ') -> "12.5"
+char *fmt_fixed(char *dst, uint16_t v, uint8_t width, uint8_t decimals, char pad);
+
+char *fmt_bcd(char *dst, uint8_t bcd);   // two digits, "59" from 0x59
+
+#define fmt_2(dst, v) fmt_u8(dst, v, 2, '0')
+
+#endif
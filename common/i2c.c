@@ -0,0 +1,81 @@
+/*
+ * File:   i2c.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+#include "board.h"
+#include "i2c.h"
+#include "probe.h"
+
+#define I2C_SSPADD ((_XTAL_FREQ / 4 / I2C_CLOCK) - 1)
+#if I2C_SSPADD < 3 || I2C_SSPADD > 255
+#error "I2C_CLOCK out of reach of the baud rate generator at this _XTAL_FREQ"
+#endif
+
+// SEN, RSEN, PEN, RCEN or ACKEN pending, or a transmit in progress (R/W)
+static void i2c_wait_idle(void){
+    while((SSPCON2 & 0x1F) || (SSPSTAT & 0x04));
+}
+
+void i2c_init(void){
+    TRISC3 = 1;            // MSSP drives both pins open-drain
+    TRISC4 = 1;
+    SSPCON = 0x28;         // SSPEN, I2C master mode
+    SSPADD = I2C_SSPADD;
+    SSPSTAT = 0x80;        // slew rate control off (100 kHz)
+    SSPIF = 0;
+}
+
+void i2c_start(void){
+    PROBE_ENTER(P_I2C_START);
+    i2c_wait_idle();
+    SEN = 1;
+    while(SEN);
+    PROBE_EXIT(P_I2C_START);
+}
+
+void i2c_rstart(void){
+    PROBE_ENTER(P_I2C_RSTART);
+    i2c_wait_idle();
+    RSEN = 1;
+    while(RSEN);
+    PROBE_EXIT(P_I2C_RSTART);
+}
+
+void i2c_stop(void){
+    PROBE_ENTER(P_I2C_STOP);
+    i2c_wait_idle();
+    PEN = 1;
+    while(PEN);
+    PROBE_EXIT(P_I2C_STOP);
+}
+
+// START/STOP completion sets SSPIF as well, so it is cleared before the
+// byte goes out; otherwise the wait below ends at once and ACKSTAT is
+// still that of the previous byte
+uint8_t i2c_write(uint8_t data){
+    PROBE_ENTER(P_I2C_WRITE);
+    i2c_wait_idle();
+    SSPIF = 0;
+    SSPBUF = data;
+    while(!SSPIF);
+    SSPIF = 0;
+    PROBE_EXIT(P_I2C_WRITE);
+    return !SSPCON2bits.ACKSTAT;
+}
+
+uint8_t i2c_read(uint8_t ack){
+    PROBE_ENTER(P_I2C_READ);
+    i2c_wait_idle();
+    RCEN = 1;
+    while(!BF);
+    uint8_t data = SSPBUF;
+    i2c_wait_idle();
+    ACKDT = ack ? 0 : 1;
+    ACKEN = 1;
+    while(ACKEN);
+    PROBE_EXIT(P_I2C_READ);
+    return data;
+}
@@ -0,0 +1,28 @@
+/*
+ * File:   i2c.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// MSSP as I2C master on RC3 (SCL) / RC4 (SDA). I2C_CLOCK (Hz, default
+// 100 kHz) fixes SSPADD at compile time; every call waits for the bus
+// operation it starts, a few bit times at most.
+
+#ifndef I2C_H
+#define I2C_H
+
+#include <stdint.h>
+
+#ifndef I2C_CLOCK
+#define I2C_CLOCK 100000
+#endif
+
+void i2c_init(void);
+void i2c_start(void);
+void i2c_rstart(void);               // repeated START
+void i2c_stop(void);
+uint8_t i2c_write(uint8_t data);     // 1 if the slave ACKed
+uint8_t i2c_read(uint8_t ack);       // ack = 0 on the last byte (NACK)
+
+#endif
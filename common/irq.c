@@ -0,0 +1,127 @@
+/*
+ * File:   irq.c
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 9:00 AM
+ */
+
+#include <xc.h>
+#include "irq.h"
+#include "tick.h"
+#ifdef IRQ_STATS
+#include "fmt.h"
+#endif
+
+static irq_handler_t handlers[IRQ_SOURCES];
+
+uint16_t irq_unhandled;
+
+#ifdef IRQ_STATS
+// Timer1 read for the ISR side: tick_fine() is called from the main line,
+// so the interrupt keeps its own copy (same rollover re-read)
+#define ISR_FINE(t) do { \
+        uint8_t hi_, lo_; \
+        do { hi_ = TMR1H; lo_ = TMR1L; } while(hi_ != TMR1H); \
+        t = ((uint16_t)hi_ << 8) | lo_; \
+    } while(0)
+
+irq_stat_t irq_stats[IRQ_SOURCES];
+uint16_t irq_pass_max;
+uint16_t irq_off_max;
+static uint16_t off_start;
+#endif
+
+void irq_register(uint8_t source, irq_handler_t fn){
+    if(source < IRQ_SOURCES) handlers[source] = fn;
+}
+
+#ifdef IRQ_STATS
+static void run(uint8_t source){
+    irq_stat_t *s = &irq_stats[source];
+    uint16_t t, end;
+    ISR_FINE(t);
+    handlers[source]();
+    ISR_FINE(end);
+    t = end - t;
+    s->count++;
+    if(t > s->max) s->max = t;
+}
+#else
+#define run(source) handlers[source]()
+#endif
+
+// One source: its handler, or off for good if it has none
+#define DISPATCH(source, ie, flag) \
+    if(ie && flag){ \
+        if(handlers[source]) run(source); \
+        else { ie = 0; irq_unhandled++; } \
+    }
+
+void __interrupt() isr(void){
+#ifdef IRQ_STATS
+    uint16_t t, end;
+    ISR_FINE(t);
+#endif
+    DISPATCH(IRQ_RX, RCIE, RCIF)
+    DISPATCH(IRQ_TMR2, TMR2IE, TMR2IF)
+    DISPATCH(IRQ_INT, INTE, INTF)
+    DISPATCH(IRQ_RB, RBIE, RBIF)
+    DISPATCH(IRQ_SSP, SSPIE, SSPIF)
+    DISPATCH(IRQ_CCP1, CCP1IE, CCP1IF)
+    DISPATCH(IRQ_TMR1, TMR1IE, TMR1IF)
+    DISPATCH(IRQ_TMR0, T0IE, T0IF)
+    DISPATCH(IRQ_AD, ADIE, ADIF)
+    DISPATCH(IRQ_TX, TXIE, TXIF)
+#ifdef IRQ_STATS
+    ISR_FINE(end);
+    t = end - t;
+    if(t > irq_pass_max) irq_pass_max = t;
+#endif
+}
+
+#ifdef IRQ_STATS
+void irq_off_start(void){
+    off_start = tick_fine();
+}
+
+void irq_off_end(void){
+    uint16_t t = tick_fine() - off_start;
+    if(t > irq_off_max) irq_off_max = t;
+}
+
+static char reply[32];
+
+static char *put_us(char *p, const char *name, uint16_t t){
+    while(*name) *p++ = *name++;
+    p = fmt_u16(p, tick_fine_us(t), 1, ' ');
+    *p++ = 'u';
+    *p++ = 's';
+    *p = '\0';
+    return p;
+}
+
+const char *irq_cmd(const char *arg){
+    char *p = reply;
+    if(arg[0] == 'r'){
+        for(uint8_t i = 0; i < IRQ_SOURCES; i++) irq_stats[i].count = irq_stats[i].max = 0;
+        irq_pass_max = irq_off_max = 0;
+        return "OK";
+    }
+    if(arg[0] >= '0' && arg[0] <= '9'){
+        uint8_t n = (uint8_t)(arg[0] - '0');
+        if(arg[1]) n = (uint8_t)(n * 10 + arg[1] - '0');
+        if(n >= IRQ_SOURCES) return "ERR range";
+        p = fmt_u8(p, n, 1, ' ');
+        *p++ = ' ';
+        *p++ = 'n';
+        *p++ = '=';
+        p = fmt_u16(p, irq_stats[n].count, 1, ' ');
+        put_us(p, " max=", irq_stats[n].max);
+        return reply;
+    }
+    p = put_us(p, "pass=", irq_pass_max);
+    p = put_us(p, " off=", irq_off_max);
+    put_us(p, " lat=", irq_pass_max + irq_off_max);
+    return reply;
+}
+#endif
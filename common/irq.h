@@ -0,0 +1,90 @@
+/*
+ * File:   irq.h
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 9:00 AM
+ */
+
+// The one interrupt handler every firmware links: irq.c defines isr() and
+// dispatches to the handlers registered per source. Each pass checks the
+// sources once, in the fixed order of the enum below (highest priority
+// first), and runs every one whose enable and flag bits are both set; a
+// flag raised meanwhile by a source already passed re-enters straight
+// after the return. RX leads because the USART holds only two bytes, and
+// TX comes last because a transmit refill can wait a byte time.
+//
+//   irq_register(IRQ_TMR2, tick_isr);
+//   irq_register(IRQ_RX, uart_rx_isr);
+//   irq_register(IRQ_TX, uart_tx_isr);
+//   ei();
+//
+// Register before ei(). A handler clears its own flag (or its enable bit
+// when the flag cannot be cleared, as TXIF). A source that is enabled and
+// raised with no handler has its enable bit cleared and is counted in
+// irq_unhandled, so it cannot lock the core in a stream of interrupts.
+//
+// XC8 saves the context the handlers use, so keep them short and call
+// nothing from them that the main line also calls (the compiler would
+// have to duplicate it). Main-line code that must not be interrupted
+// brackets the section with IRQ_OFF()/IRQ_ON().
+//
+// With IRQ_STATS defined project-wide, Timer1 (1.6 us) measures each
+// handler, each whole pass and each IRQ_OFF() window, keeping the worst
+// cases. A source then waits at most irq_off_max + irq_pass_max (plus
+// the interrupt entry) between raising its flag and its handler starting:
+// the latency budget RX and the tick can count on. irq_cmd() reports them
+// on the console: "irq" gives the pass, off window and that sum, "irq <n>"
+// source n's count and worst handler time; "irq reset" clears them. The
+// ISR reads Timer1 through its own macro in irq.c, so tick_fine() stays
+// main-line only.
+
+#ifndef IRQ_H
+#define IRQ_H
+
+#include <stdint.h>
+
+enum {
+    IRQ_RX,         // RCIF, USART receive
+    IRQ_TMR2,       // TMR2IF, the 1 ms tick
+    IRQ_INT,        // INTF, RB0/INT edge
+    IRQ_RB,         // RBIF, RB4-RB7 change
+    IRQ_SSP,        // SSPIF, MSSP (I2C/SPI)
+    IRQ_CCP1,       // CCP1IF
+    IRQ_TMR1,       // TMR1IF
+    IRQ_TMR0,       // T0IF
+    IRQ_AD,         // ADIF
+    IRQ_TX,         // TXIF, USART transmit
+    IRQ_SOURCES
+};
+
+typedef void (*irq_handler_t)(void);
+
+void irq_register(uint8_t source, irq_handler_t fn);   // 0 removes
+
+extern uint16_t irq_unhandled;
+
+#ifdef IRQ_STATS
+typedef struct {
+    uint16_t count;
+    uint16_t max;              // Timer1 counts, the handler alone
+} irq_stat_t;
+
+extern irq_stat_t irq_stats[IRQ_SOURCES];
+extern uint16_t irq_pass_max;  // Timer1 counts, dispatch included
+extern uint16_t irq_off_max;   // longest IRQ_OFF() window
+
+void irq_off_start(void);
+void irq_off_end(void);
+const char *irq_cmd(const char *arg);
+
+#define IRQ_OFF()  do { irq_saved = GIE; di(); irq_off_start(); } while(0)
+#define IRQ_ON()   do { irq_off_end(); if(irq_saved) ei(); } while(0)
+#else
+#define IRQ_OFF()  do { irq_saved = GIE; di(); } while(0)
+#define IRQ_ON()   do { if(irq_saved) ei(); } while(0)
+#endif
+
+// Where IRQ_OFF() is used: uint8_t irq_saved; holds the caller's GIE
+#define IRQ_SAVE   uint8_t irq_saved
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * File:   journal.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 2:00 PM
+ */
+
+#include <string.h>
+#include "journal.h"
+#include "i2c.h"
+#include "crc.h"
+#include "telemetry.h"
+#include "uart.h"
+#include "tick.h"
+
+#define CTRL_W (JOURNAL_EE_ADDR << 1)
+#define CTRL_R (CTRL_W | 1)
+#define SEQ_ERASED 0xFFFFFFFFUL
+#define SLOT_MASK (JOURNAL_SLOTS - 1)     // power of two, as 24Cxx sizes are
+
+enum { OP_IDLE, OP_WRITE, OP_READ };
+
+uint32_t journal_next;
+uint16_t journal_dropped;
+
+static uint8_t page[JOURNAL_EE_PAGE];   // RAM copy of the page being filled
+static uint16_t page_addr;
+static uint8_t page_done;                // bytes of page[] already in the EEPROM
+static uint8_t page_fill;                // bytes of page[] holding records
+static uint16_t fill_tick;               // when the oldest unwritten record was added
+
+static uint8_t op;                       // transfer in progress
+static uint8_t step;                     // I2C byte within it
+static uint8_t wr_end;                   // page write covers page[page_done..wr_end)
+
+static uint32_t exp_seq, exp_end;        // export: next record and one past the last
+static uint32_t rd_seq;
+static uint16_t rd_addr;
+static uint8_t rec[JOURNAL_REC];
+
+static uint16_t slot_addr(uint32_t seq){
+    uint16_t next_slot = (page_addr + page_fill) / JOURNAL_REC;
+    return (uint16_t)((next_slot - (journal_next - seq)) & SLOT_MASK) * JOURNAL_REC;
+}
+
+// Blocking random read, boot only
+static uint8_t ee_read(uint16_t addr, uint8_t *buf, uint8_t n){
+    i2c_start();
+    if(!i2c_write(CTRL_W)){
+        i2c_stop();
+        return 0;
+    }
+    i2c_write(addr >> 8);
+    i2c_write(addr & 0xFF);
+    i2c_rstart();
+    i2c_write(CTRL_R);
+    while(n--) *buf++ = i2c_read(n != 0);
+    i2c_stop();
+    return 1;
+}
+
+static uint32_t seq_at(uint16_t slot){
+    uint8_t b[4];
+    if(!ee_read(slot * JOURNAL_REC, b, 4)) return SEQ_ERASED;
+    return b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+void journal_init(void){
+    uint32_t first = seq_at(0);
+    uint16_t slot = 0;
+
+    journal_next = 0;
+    if(first != SEQ_ERASED){
+        uint16_t lo = 0, hi = JOURNAL_SLOTS - 1;   // newest record is in slot lo..hi
+        while(lo < hi){
+            uint16_t mid = (lo + hi + 1) >> 1;
+            if(seq_at(mid) == first + mid) lo = mid;
+            else hi = mid - 1;
+        }
+        journal_next = first + lo + 1;
+        slot = (lo + 1) & SLOT_MASK;
+    }
+    page_addr = (slot * JOURNAL_REC) & ~(JOURNAL_EE_PAGE - 1);
+    page_done = page_fill = (slot * JOURNAL_REC) & (JOURNAL_EE_PAGE - 1);
+    op = OP_IDLE;
+}
+
+uint8_t journal_add(const uint8_t *data){
+    uint8_t *r = &page[page_fill];
+    uint32_t s = journal_next;
+    uint16_t crc = CRC16_INIT;
+
+    if(page_fill == JOURNAL_EE_PAGE){    // full page not written out yet
+        journal_dropped++;
+        return 0;
+    }
+    r[0] = (uint8_t)s;
+    r[1] = (uint8_t)(s >> 8);
+    r[2] = (uint8_t)(s >> 16);
+    r[3] = (uint8_t)(s >> 24);
+    memcpy(r + 4, data, JOURNAL_DATA);
+    for(uint8_t i = 0; i < JOURNAL_REC - 1; i++) crc = crc16_update(crc, r[i]);
+    r[JOURNAL_REC - 1] = (uint8_t)crc;
+
+    if(page_fill == page_done) fill_tick = tick_now();
+    page_fill += JOURNAL_REC;
+    journal_next++;
+    return 1;
+}
+
+void journal_export(uint32_t since){
+    uint32_t oldest = journal_next > JOURNAL_SLOTS ? journal_next - JOURNAL_SLOTS : 0;
+    exp_seq = since < oldest ? oldest : since;
+    exp_end = journal_next;
+}
+
+// START and the control byte; a NACK means the chip is still in its write
+// cycle (or absent), so the transfer starts over on the next call
+static uint8_t ee_select(void){
+    i2c_start();
+    if(i2c_write(CTRL_W)) return 1;
+    i2c_stop();
+    return 0;
+}
+
+static void write_step(void){
+    uint16_t addr = page_addr + page_done;
+    if(step == 0){
+        if(!ee_select()) return;
+    } else if(step == 1){
+        i2c_write(addr >> 8);
+    } else if(step == 2){
+        i2c_write(addr & 0xFF);
+    } else {
+        uint8_t i = page_done + step - 3;
+        i2c_write(page[i]);
+        if(i + 1 == wr_end){
+            i2c_stop();                  // starts the chip's write cycle
+            page_done = wr_end;
+            if(page_done == JOURNAL_EE_PAGE){
+                page_addr = (page_addr + JOURNAL_EE_PAGE) & (JOURNAL_EE_SIZE - 1);
+                page_done = page_fill = 0;
+            } else if(page_fill > page_done){
+                fill_tick = tick_now();  // added while this page write ran
+            }
+            op = OP_IDLE;
+            return;
+        }
+    }
+    step++;
+}
+
+static void read_step(void){
+    if(step == 0){
+        rd_seq = exp_seq;
+        rd_addr = slot_addr(rd_seq);
+        if(!ee_select()) return;
+    } else if(step == 1){
+        i2c_write(rd_addr >> 8);
+    } else if(step == 2){
+        i2c_write(rd_addr & 0xFF);
+    } else if(step == 3){
+        i2c_rstart();
+        i2c_write(CTRL_R);
+    } else if(step < 4 + JOURNAL_REC){
+        uint8_t i = step - 4;
+        rec[i] = i2c_read(i != JOURNAL_REC - 1);
+        if(i == JOURNAL_REC - 1) i2c_stop();
+    } else {
+        if(uart_tx_room() < TELEM_FRAME_LEN(JOURNAL_REC)) return;
+        if(exp_seq == rd_seq){           // not restarted by a new export meanwhile
+            telem_send(TELEM_JOURNAL, rec, JOURNAL_REC);
+            exp_seq++;
+        }
+        op = OP_IDLE;
+        return;
+    }
+    step++;
+}
+
+// Unwritten records go out first, so an export never reads a slot whose
+// record is still only in RAM
+void journal_poll(void){
+    if(op == OP_IDLE){
+        uint8_t exporting = exp_seq < exp_end;
+        if(page_fill > page_done && (page_fill == JOURNAL_EE_PAGE || exporting ||
+                                     (uint16_t)(tick_now() - fill_tick) >= JOURNAL_FLUSH_MS)){
+            op = OP_WRITE;
+            wr_end = page_fill;
+        } else if(exporting){
+            op = OP_READ;
+        } else {
+            return;
+        }
+        step = 0;
+    }
+    if(op == OP_WRITE) write_step();
+    else read_step();
+}
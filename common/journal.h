@@ -0,0 +1,65 @@
+/*
+ * File:   journal.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 2:00 PM
+ */
+
+// Append-only journal of 16-byte records in an external 24Cxx I2C EEPROM
+// used as a ring, oldest record overwritten first:
+//
+//   0..3    SEQ    record number, little endian, never reused
+//   4..14   DATA   JOURNAL_DATA bytes from the firmware
+//   15      CHECK  low byte of CRC-16/CCITT over SEQ and DATA
+//
+// Records collect in a RAM copy of the current EEPROM page and go out as
+// one page write when the page is full, JOURNAL_FLUSH_MS after the first
+// unwritten record, or before an export - so a 32-byte page costs one
+// 5 ms write cycle instead of two. journal_poll() moves one I2C byte per
+// call (about 100 us at 100 kHz) and answers a busy chip (NACK during its
+// write cycle) by trying again on the next call, so it never waits.
+//
+// journal_export(n) streams every record from sequence n on as TELEM_JOURNAL
+// frames; a host keeps the last sequence it holds and asks for the rest.
+// Records older than the ring are gone: the export starts at the oldest.
+//
+// journal_init() finds the newest record by binary search over the slots
+// (sequence numbers rise by one from slot 0 up to the newest), a handful
+// of reads at boot. Call i2c_init() first. A page write or record read
+// keeps the bus between calls, so nothing else may use the I2C bus.
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdint.h>
+
+#ifndef JOURNAL_EE_ADDR
+#define JOURNAL_EE_ADDR 0x50      // 7-bit, A2-A0 low
+#endif
+#ifndef JOURNAL_EE_SIZE
+#define JOURNAL_EE_SIZE 4096      // 24C32; two address bytes
+#endif
+#ifndef JOURNAL_EE_PAGE
+#define JOURNAL_EE_PAGE 32
+#endif
+#ifndef JOURNAL_FLUSH_MS
+#define JOURNAL_FLUSH_MS 5000
+#endif
+
+#define JOURNAL_REC 16
+#define JOURNAL_DATA 11
+#define JOURNAL_SLOTS (JOURNAL_EE_SIZE / JOURNAL_REC)
+
+#if JOURNAL_EE_PAGE % JOURNAL_REC
+#error "JOURNAL_EE_PAGE must hold whole records"
+#endif
+
+extern uint32_t journal_next;     // sequence number the next record gets
+extern uint16_t journal_dropped;  // records lost: the page buffer was still full
+
+void journal_init(void);
+uint8_t journal_add(const uint8_t *data);   // JOURNAL_DATA bytes; 0 if dropped
+void journal_export(uint32_t since);
+void journal_poll(void);                    // call from a periodic task
+
+#endif
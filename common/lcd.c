@@ -0,0 +1,54 @@
+/*
+ * File:   lcd.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+#include "board.h"
+#include "lcd.h"
+#include "probe.h"
+
+// Latched on the falling edge of a 1 us EN pulse
+static void lcd_write(uint8_t rs, uint8_t v){
+    LCD_RS = rs;
+    LCD_RW = 0;
+    LCD_DATA = v;
+    LCD_EN = 1;
+    __delay_us(1);
+    LCD_EN = 0;
+}
+
+void lcd_cmd(uint8_t cmd){
+    PROBE_ENTER(P_LCD_CMD);
+    lcd_write(0, cmd);
+    if(cmd <= 0x03) __delay_ms(LCD_CLEAR_MS);   // clear, home
+    else __delay_us(LCD_EXEC_US);
+    PROBE_EXIT(P_LCD_CMD);
+}
+
+void lcd_data(uint8_t data){
+    PROBE_ENTER(P_LCD_DATA);
+    lcd_write(1, data);
+    __delay_us(LCD_EXEC_US);
+    PROBE_EXIT(P_LCD_DATA);
+}
+
+void lcd_string(const char *str){
+    while(*str){
+        lcd_data(*str++);
+    }
+}
+
+void lcd_init(void){
+    LCD_EN = 0;
+    LCD_DATA_TRIS = 0x00;
+    LCD_RS_TRIS = 0;
+    LCD_RW_TRIS = 0;
+    LCD_EN_TRIS = 0;
+    __delay_ms(15);        // VDD to first command
+    lcd_cmd(0x38);         // 8-bit, 2-line, 5x7
+    lcd_cmd(0x0C);         // display on, cursor off
+    lcd_cmd(0x06);         // increment cursor
+    lcd_cmd(0x01);         // clear
+}
@@ -0,0 +1,34 @@
+/*
+ * File:   lcd.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 9:00 AM
+ */
+
+// HD44780 16x2 LCD on an 8-bit bus, write only. The pins come from the
+// board header (boards/<board>/board.h on the project include path), so
+// every RS/EN access compiles to a single bcf/bsf:
+//
+//   LCD_DATA, LCD_DATA_TRIS        data port and its TRIS register
+//   LCD_RS, LCD_RW, LCD_EN         control bits, e.g. RB0
+//   LCD_RS_TRIS ... LCD_EN_TRIS    their TRIS bits
+//
+// Each write pulses EN for 1 us (450 ns minimum) and then waits out the
+// controller's execution time: LCD_EXEC_US, 37 us at the nominal 270 kHz
+// oscillator with margin for a slow module, or LCD_CLEAR_MS for clear and
+// home (1.52 ms). A 32-character redraw takes about 1.7 ms.
+
+#ifndef LCD_H
+#define LCD_H
+
+#include <stdint.h>
+
+#define LCD_EXEC_US 50
+#define LCD_CLEAR_MS 2
+
+void lcd_init(void);           // waits out the 15 ms power-on time first
+void lcd_cmd(uint8_t cmd);
+void lcd_data(uint8_t data);
+void lcd_string(const char *str);
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * File:   probe.c
+ * Author: Rakesh B
+ *
+ * Created on October 23, 2026, 9:15 AM
+ */
+
+#include <xc.h>
+#include "probe.h"
+
+#ifdef PROBES
+
+#include "telemetry.h"
+#include "uart.h"
+
+static probe_t *probe_table;
+static uint8_t probe_count;
+static uint8_t dump_next;            // next probe to send, probe_count = idle
+
+void probe_init(probe_t *table, uint8_t count){
+    probe_table = table;
+    probe_count = count;
+    dump_next = count;
+}
+
+// Called with interrupts enabled from main-line code only, so no locking
+void probe_record(uint8_t id, uint16_t dt){
+    probe_t *p = &probe_table[id];
+    uint8_t bin = 0;
+    uint16_t v = dt;
+
+    if(p->count == 0xFFFF) return;   // keep sum/count consistent once full
+    p->count++;
+    p->sum += dt;
+    if(dt < p->min) p->min = dt;
+    if(dt > p->max) p->max = dt;
+
+    while(v && bin < PROBE_BINS - 1){
+        v >>= 1;
+        bin++;
+    }
+    if(p->hist[bin] != 0xFF) p->hist[bin]++;
+}
+
+void probe_dump_start(void){
+    dump_next = 0;
+}
+
+// TELEM_PROBE payload: id, count, min, max (u16), sum (u32), hist[16], name
+void probe_poll(void){
+    uint8_t frame[1 + 2 + 2 + 2 + 4 + PROBE_BINS + PROBE_NAME_MAX];
+    uint8_t len, i;
+    probe_t *p;
+
+    if(dump_next >= probe_count) return;
+    if(uart_tx_room() < TELEM_FRAME_LEN(sizeof(frame))) return;
+
+    p = &probe_table[dump_next];
+    frame[0] = dump_next;
+    frame[1] = p->count & 0xFF;
+    frame[2] = p->count >> 8;
+    frame[3] = p->min & 0xFF;
+    frame[4] = p->min >> 8;
+    frame[5] = p->max & 0xFF;
+    frame[6] = p->max >> 8;
+    frame[7] = p->sum & 0xFF;
+    frame[8] = (p->sum >> 8) & 0xFF;
+    frame[9] = (p->sum >> 16) & 0xFF;
+    frame[10] = p->sum >> 24;
+    len = 11;
+    for(i = 0; i < PROBE_BINS; i++){
+        frame[len++] = p->hist[i];
+    }
+    for(i = 0; i < PROBE_NAME_MAX && p->name[i]; i++){
+        frame[len++] = p->name[i];
+    }
+    if(telem_send(TELEM_PROBE, frame, len)) dump_next++;
+}
+
+void probe_task(void){
+    if(uart_rx_ready() && uart_rx() == PROBE_CMD) probe_dump_start();
+    probe_poll();
+}
+
+#endif
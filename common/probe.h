@@ -0,0 +1,74 @@
+/*
+ * File:   probe.h
+ * Author: Rakesh B
+ *
+ * Created on October 23, 2026, 9:15 AM
+ */
+
+// Cycle probes for hot paths. PROBE_ENTER/PROBE_EXIT stamp the free-running
+// Timer1 (tick_fine(), 1.6 us per count) and fold the difference into the
+// probe's count, min, max, sum and a log2 histogram: bin 0 counts 0, bin i
+// counts [2^(i-1), 2^i) and bin 15 everything from 2^14 (26 ms) up.
+//
+// Probes exist only when PROBES is defined project-wide (XC8 -DPROBES, or
+// `make -C host PROBES=1` for the simulator); otherwise every macro here is
+// empty and probe.c compiles to nothing. The firmware owns the table:
+//
+//   enum { P_LCD_CMD, P_LCD_DATA };
+//   #ifdef PROBES
+//   probe_t probes[] = { PROBE("lcd_cmd"), PROBE("lcd_data") };
+//   #endif
+//   ...
+//   probe_init(probes, sizeof(probes) / sizeof(probes[0]));
+//
+// Timer1 starts in tick_init(), so anything probed before that records 0.
+//
+// probe_dump_start() then streams one TELEM_PROBE frame per probe from
+// probe_poll(), which the firmware calls from a periodic task. Boards with
+// no other use for USART receive can schedule probe_task() instead: it
+// starts a dump on PROBE_CMD and polls.
+
+#ifndef PROBE_H
+#define PROBE_H
+
+#include <stdint.h>
+#include "tick.h"
+
+#define PROBE_BINS 16
+#define PROBE_CMD 'P'          // conventional USART command for a dump
+
+#ifdef PROBES
+
+typedef struct {
+    const char *name;          // at most PROBE_NAME_MAX characters are sent
+    uint16_t count;            // recording stops once this reaches 0xFFFF
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+    uint8_t hist[PROBE_BINS];  // saturating
+} probe_t;
+
+#define PROBE_NAME_MAX 16
+#define PROBE(name) { name, 0, 0xFFFF, 0, 0, {0} }
+
+void probe_init(probe_t *table, uint8_t count);
+void probe_record(uint8_t id, uint16_t dt);
+void probe_dump_start(void);
+void probe_poll(void);
+void probe_task(void);
+
+#define PROBE_ENTER(id) uint16_t probe_t0_##id = tick_fine()
+#define PROBE_EXIT(id) probe_record(id, tick_fine() - probe_t0_##id)
+
+#else
+
+#define probe_init(table, count)
+#define probe_dump_start()
+#define probe_poll()
+#define probe_task()
+#define PROBE_ENTER(id)
+#define PROBE_EXIT(id)
+
+#endif
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * File:   runstat.c
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 4:00 PM
+ */
+
+#include "runstat.h"
+
+void runstat_reset(runstat_t *s){
+    s->n = 0;
+    s->min = 0x7FFF;
+    s->max = -0x7FFF - 1;
+    s->mean = 0;
+    s->var = 0;
+}
+
+void runstat_add(runstat_t *s, int16_t x){
+    int32_t x16 = (int32_t)x << 4;
+    int32_t delta;
+
+    if(x < s->min) s->min = x;
+    if(x > s->max) s->max = x;
+    if(s->n < RUNSTAT_WINDOW) s->n++;
+    if(s->n == 1){
+        s->mean = x16;
+        return;
+    }
+    delta = x16 - s->mean;
+    s->mean += delta / s->n;
+    s->var += (delta * (x16 - s->mean) - s->var) / s->n;
+    if(s->var < 0) s->var = 0;           // truncation on a falling variance
+}
+
+int16_t runstat_mean(const runstat_t *s){
+    return (int16_t)((s->mean + (s->mean < 0 ? -8 : 8)) / 16);
+}
+
+// Bit-by-bit integer square root of var; sqrt(x 256) is x 16
+uint16_t runstat_sd16(const runstat_t *s){
+    uint32_t v = (uint32_t)s->var;
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while(bit > v) bit >>= 2;
+    while(bit){
+        if(v >= root + bit){
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
@@ -0,0 +1,43 @@
+/*
+ * File:   runstat.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 4:00 PM
+ */
+
+// Running min/max/mean/variance of integer samples, updated one sample at
+// a time with Welford's method in fixed point - no sample history, no
+// floating point:
+//
+//   delta = x - mean;  mean += delta / n;  var += (delta * (x - mean) - var) / n
+//
+// mean is kept in 1/16 counts and var (population variance) in 1/256
+// counts^2, so samples must stay within +-1023 (a 10-bit ADC reading) for
+// the products to fit 32 bits. n stops at RUNSTAT_WINDOW: from there on mean and variance
+// follow an exponential window of that many samples instead of the whole
+// run, which keeps a days-long run responsive and the state bounded.
+// min and max cover everything since runstat_reset().
+
+#ifndef RUNSTAT_H
+#define RUNSTAT_H
+
+#include <stdint.h>
+
+#ifndef RUNSTAT_WINDOW
+#define RUNSTAT_WINDOW 1024
+#endif
+
+typedef struct {
+    uint16_t n;
+    int16_t min;
+    int16_t max;
+    int32_t mean;       // x 16
+    int32_t var;        // x 256
+} runstat_t;
+
+void runstat_reset(runstat_t *s);
+void runstat_add(runstat_t *s, int16_t x);
+int16_t runstat_mean(const runstat_t *s);      // rounded to counts
+uint16_t runstat_sd16(const runstat_t *s);     // standard deviation x 16
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * File:   sched.c
+ * Author: Rakesh B
+ *
+ * Created on October 20, 2026, 2:10 PM
+ */
+
+#include <xc.h>
+#include "sched.h"
+
+sched_task_t *sched_tasks;
+uint8_t sched_count;
+
+// Phases are relative to the moment the scheduler starts, not to reset
+void sched_init(sched_task_t *tasks, uint8_t count){
+    uint16_t now = tick_now();
+    sched_tasks = tasks;
+    sched_count = count;
+    for(uint8_t i = 0; i < count; i++){
+        tasks[i].next += now;
+    }
+}
+
+void sched_wake(uint8_t id, uint16_t delay_ms){
+    sched_tasks[id].next = tick_now() + delay_ms;
+    sched_tasks[id].armed = 1;
+}
+
+void sched_stop(uint8_t id){
+    sched_tasks[id].armed = 0;
+}
+
+void sched_run(void){
+    uint16_t now = tick_now();
+    sched_task_t *t = sched_tasks;
+
+    for(uint8_t i = 0; i < sched_count; i++, t++){
+        if(!t->armed) continue;
+        uint16_t late = now - t->next;
+        if(late & 0x8000) continue;        // release still in the future
+
+        if(late > t->late_max) t->late_max = late;
+        if(t->period == 0){
+            t->armed = 0;
+        } else {
+            t->next += t->period;
+            if(late >= t->period){         // do not replay missed releases
+                t->skipped += late / t->period;
+                t->next = now + t->period;
+            }
+        }
+
+        uint16_t start = tick_fine();
+        t->fn();
+        uint16_t dt = tick_fine() - start;
+
+        t->runs++;
+        t->time_sum += dt;
+        if(dt > t->time_max) t->time_max = dt;
+        if(t->budget && dt > t->budget) t->overruns++;
+        return;                            // rescan from the highest priority
+    }
+    NOP();                                 // idle: nothing due this pass
+}
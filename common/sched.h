@@ -0,0 +1,58 @@
+/*
+ * File:   sched.h
+ * Author: Rakesh B
+ *
+ * Created on October 20, 2026, 2:10 PM
+ */
+
+// Cooperative scheduler on the 1 ms tick. Each task has a period, a phase
+// (first release) and a runtime budget. Table order is priority: after any
+// task runs the scan restarts from the top, so a task waits at most for the
+// longest single task below it.
+//
+// Tasks must not block; anything that used to __delay_ms() becomes state
+// plus a later release. A driver's short waits are part of the runtime:
+// an LCD write is about 50 us and a clear 2 ms, so a display task fits a
+// budget of a few ms. Periods, phases and wake delays are compared on the
+// 16-bit tick, so they must stay below 32768 ms; count releases of a
+// shorter task for anything slower. Statistics are kept per task for the
+// console and the probes.
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include "tick.h"
+
+typedef struct {
+    void (*fn)(void);
+    uint16_t period;      // ms (< 32768), 0 = one-shot (re-armed with sched_wake)
+    uint16_t next;        // tick of the next release
+    uint16_t budget;      // Timer1 counts, 0 = unchecked
+    uint8_t armed;
+
+    // statistics
+    uint16_t runs;
+    uint16_t overruns;    // runs longer than budget
+    uint16_t skipped;     // releases dropped because the task fell a period behind
+    uint16_t late_max;    // worst release-to-start delay, ms
+    uint16_t time_max;    // worst runtime, Timer1 counts
+    uint32_t time_sum;
+} sched_task_t;
+
+// period and phase in ms, budget in us
+#define SCHED_TASK(fn, period, phase, budget) \
+    { fn, period, phase, TICK_FINE_US(budget), 1, 0, 0, 0, 0, 0, 0 }
+#define SCHED_ONESHOT(fn, budget) \
+    { fn, 0, 0, TICK_FINE_US(budget), 0, 0, 0, 0, 0, 0, 0 }
+
+extern sched_task_t *sched_tasks;
+extern uint8_t sched_count;
+
+void sched_init(sched_task_t *tasks, uint8_t count);
+void sched_run(void);                       // call from while(1)
+
+void sched_wake(uint8_t id, uint16_t delay_ms);   // (re)arm, first run after delay_ms
+void sched_stop(uint8_t id);
+
+#endif
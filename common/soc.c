@@ -0,0 +1,78 @@
+/*
+ * File:   soc.c
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 2:00 PM
+ */
+
+#include "soc.h"
+
+// Sampled from 10 % steps: flooded 11.36-12.73 V, AGM 11.51-12.85 V,
+// LiFePO4 (4S) 12.00-13.60 V with 12.80 V at 10 % and 13.35 V at 90 %
+static const uint8_t flooded[] = {
+    0, 2, 6, 11, 15, 19, 23, 28, 32, 36, 41, 45,
+    50, 54, 59, 64, 69, 74, 78, 84, 89, 95, 100,
+};
+
+static const uint8_t agm[] = {
+    0, 1, 4, 7, 11, 15, 19, 23, 28, 32, 36, 41,
+    45, 50, 55, 60, 66, 71, 76, 82, 89, 95, 100,
+};
+
+static const uint8_t lifepo4[] = {
+    0, 0, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4, 5, 5, 6, 6, 6,
+    7, 7, 8, 8, 8, 9, 9, 10, 10, 13, 16, 20, 23, 26, 29, 32,
+    36, 39, 47, 53, 58, 63, 70, 80, 85, 89, 91, 92, 94, 95, 96,
+    97, 99, 100,
+};
+
+const soc_curve_t soc_curves[SOC_CHEMISTRIES] = {
+    { 11328, 6, sizeof(flooded), flooded },
+    { 11456, 6, sizeof(agm), agm },
+    { 12000, 5, sizeof(lifepo4), lifepo4 },
+};
+
+uint8_t soc_from_mv(const soc_curve_t *c, uint16_t mv){
+    uint16_t d;
+    uint8_t i, f, lo, hi;
+
+    if(mv <= c->base_mv) return 0;
+    d = mv - c->base_mv;
+    if((d >> c->shift) >= (uint16_t)(c->points - 1)) return 100;
+    i = (uint8_t)(d >> c->shift);
+    f = (uint8_t)d & (uint8_t)((1 << c->shift) - 1);
+    lo = c->pct[i];
+    hi = c->pct[i + 1];
+    return lo + (uint8_t)(((uint16_t)(uint8_t)(hi - lo) * f + (1 << (c->shift - 1))) >> c->shift);
+}
+
+void soc_full(soc_pack_t *p, uint32_t now){
+    p->pct = 100;
+    p->state = SOC_SEED;
+    p->since = now;
+}
+
+uint8_t soc_update(soc_pack_t *p, const soc_curve_t *c, uint16_t mv,
+                   uint8_t charging, uint32_t now, uint32_t rest_ms){
+    uint16_t moved = mv > p->mv ? mv - p->mv : p->mv - mv;
+
+    p->mv = mv;
+    if(charging){
+        p->since = now;
+        return 0;
+    }
+    if(p->state == SOC_NONE){
+        p->pct = soc_from_mv(c, mv);
+        p->state = SOC_SEED;
+        p->since = now;
+        return 1;
+    }
+    if(moved > SOC_STILL_MV){
+        p->since = now;
+        return 0;
+    }
+    if(now - p->since < rest_ms) return 0;
+    p->pct = soc_from_mv(c, mv);
+    p->state = SOC_RESTED;
+    return 1;
+}
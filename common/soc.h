@@ -0,0 +1,70 @@
+/*
+ * File:   soc.h
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 2:00 PM
+ */
+
+// State of charge of a 12 V pack from its open-circuit voltage. Each
+// chemistry's OCV curve is a table of percentages at evenly spaced
+// voltages in program memory, so finding the segment is a subtract and a
+// shift and the interpolation one small multiply:
+//
+//   d = mv - base_mv;  i = d >> shift;  f = d & ((1 << shift) - 1)
+//   soc = pct[i] + ((pct[i + 1] - pct[i]) * f) >> shift   (rounded)
+//
+// Against the piecewise-linear curve the tables were sampled from, the
+// result is within 1.0 % (flooded), 1.4 % (AGM) and 2.3 % (LiFePO4, on its
+// flat middle); host/soc_check.c holds the source curves and checks this
+// and the rest detector below (make -C host soc). The curves are typical
+// rested values at 25 C; a pack maker's own curve goes in soc.c the same
+// way, with its source curve added to the check.
+//
+// Terminal voltage is only OCV once a pack has rested: not charged, and
+// not moving by more than SOC_STILL_MV between readings (a load comes and
+// goes), for the rest time. soc_update() takes every reading and only
+// moves the estimate after such a rest, so a pack under charge or load
+// keeps the SoC it had when it last rested. The first reading after reset
+// seeds the estimate if the pack is not charging then. A pack that reaches
+// its full voltage is set to 100 % with soc_full(), since the SoC from
+// before its charge no longer holds, and keeps that until it has rested.
+
+#ifndef SOC_H
+#define SOC_H
+
+#include <stdint.h>
+
+enum { SOC_FLOODED, SOC_AGM, SOC_LIFEPO4, SOC_CHEMISTRIES };
+
+#ifndef SOC_STILL_MV
+#define SOC_STILL_MV 100        // two ADC steps on a 15 V divider
+#endif
+
+typedef struct {
+    uint16_t base_mv;           // voltage of pct[0]
+    uint8_t shift;              // points (1 << shift) mV apart
+    uint8_t points;
+    const uint8_t *pct;         // rising, 0 first and 100 last
+} soc_curve_t;
+
+extern const soc_curve_t soc_curves[SOC_CHEMISTRIES];
+
+enum { SOC_NONE, SOC_SEED, SOC_RESTED };
+
+typedef struct {
+    uint16_t mv;                // last reading
+    uint32_t since;             // tick_now32() when the pack last charged or moved
+    uint8_t pct;
+    uint8_t state;              // SOC_NONE until the first estimate
+} soc_pack_t;
+
+uint8_t soc_from_mv(const soc_curve_t *c, uint16_t mv);
+
+void soc_full(soc_pack_t *p, uint32_t now);
+
+// One reading of a pack; charging: its charger was on during the reading.
+// Returns 1 when pct was updated
+uint8_t soc_update(soc_pack_t *p, const soc_curve_t *c, uint16_t mv,
+                   uint8_t charging, uint32_t now, uint32_t rest_ms);
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * File:   telemetry.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 11:00 AM
+ */
+
+#include <xc.h>
+#include "telemetry.h"
+#include "crc.h"
+#include "tick.h"
+#include "uart.h"
+
+uint8_t telem_node;
+uint16_t telem_dropped;
+static uint8_t telem_seq;
+
+static uint16_t put_crc(uint16_t crc, uint8_t c){
+    uart_put(c);
+    return crc16_update(crc, c);
+}
+
+uint8_t telem_send(uint8_t type, const uint8_t *payload, uint8_t len){
+    if(uart_tx_room() < TELEM_FRAME_LEN(len)){
+        telem_dropped++;
+        return 0;
+    }
+    uint32_t t = tick_now32();
+    uint16_t crc = CRC16_INIT;
+
+    uart_put(TELEM_SYNC);
+    crc = put_crc(crc, len);
+    crc = put_crc(crc, type);
+    crc = put_crc(crc, telem_node);
+    crc = put_crc(crc, telem_seq++);
+    crc = put_crc(crc, (uint8_t)t);
+    crc = put_crc(crc, (uint8_t)(t >> 8));
+    crc = put_crc(crc, (uint8_t)(t >> 16));
+    crc = put_crc(crc, (uint8_t)(t >> 24));
+    while(len--){
+        crc = put_crc(crc, *payload++);
+    }
+    uart_put((uint8_t)crc);
+    uart_put((uint8_t)(crc >> 8));
+    return 1;
+}
+
+uint8_t telem_build(uint8_t *buf, uint8_t type, const uint8_t *payload, uint8_t len){
+    uint32_t t = tick_now32();
+    uint16_t crc = CRC16_INIT;
+    uint8_t n = TELEM_HDR_LEN;
+
+    buf[0] = TELEM_SYNC;
+    buf[1] = len;
+    buf[2] = type;
+    buf[3] = telem_node;
+    buf[4] = telem_seq++;
+    buf[5] = (uint8_t)t;
+    buf[6] = (uint8_t)(t >> 8);
+    buf[7] = (uint8_t)(t >> 16);
+    buf[8] = (uint8_t)(t >> 24);
+    while(len--) buf[n++] = *payload++;
+    for(uint8_t i = 1; i < n; i++) crc = crc16_update(crc, buf[i]);
+    buf[n++] = (uint8_t)crc;
+    buf[n++] = (uint8_t)(crc >> 8);
+    return n;
+}
@@ -0,0 +1,57 @@
+/*
+ * File:   telemetry.h
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 11:00 AM
+ */
+
+// Binary telemetry frame, little endian:
+//
+//   0     SYNC   0xA5
+//   1     LEN    payload length
+//   2     TYPE   TELEM_* record type
+//   3     NODE   board address
+//   4     SEQ    frame counter, wraps at 255
+//   5..8  TICK   ms since boot
+//   9..   payload (LEN bytes)
+//   end   CRC16  CRC-16/CCITT over LEN..payload (everything but SYNC)
+//
+// The layout is shared with the host decoder, so keep this header free of
+// device includes.
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+#define TELEM_SYNC     0xA5
+#define TELEM_HDR_LEN  9
+#define TELEM_CRC_LEN  2
+#define TELEM_MAX_PAYLOAD 48
+
+// Record types
+#define TELEM_BATTERY  0x01   // volt[4] (0.1v), charging channel (0 = none, 1-4), faults (BATT_*)
+#define TELEM_TEMP     0x02   // channel count, adc[n] (u16, LM35 10mV/C, 5V ref)
+#define TELEM_LOG      0x03   // sample kind (TELEM_*), one eelog page (see eelog.h)
+#define TELEM_PROBE    0x04   // probe id, count, min, max, sum, hist[16], name (see probe.h)
+#define TELEM_JOURNAL  0x05   // one journal record: seq (u32), data[11], check (see journal.h)
+#define TELEM_POLL     0x06   // master to NODE on an RS-485 bus, no payload (see bus.h)
+
+// TELEM_BATTERY fault flags
+#define BATT_LOW       0x01   // a pack is under Low_Volt
+#define BATT_SENSE     0x02   // a divider reads at an ADC rail: open or shorted
+#define BATT_UNCAL     0x04   // running on the default calibration
+
+#define TELEM_FRAME_LEN(n) (TELEM_HDR_LEN + (n) + TELEM_CRC_LEN)
+
+extern uint8_t telem_node;
+extern uint16_t telem_dropped;
+
+// Queue one frame on the UART ring. Returns 0 (and counts a drop) when
+// the ring has no room for the whole frame; never waits.
+uint8_t telem_send(uint8_t type, const uint8_t *payload, uint8_t len);
+
+// The same frame written to buf (TELEM_FRAME_LEN(len) bytes); returns its length
+uint8_t telem_build(uint8_t *buf, uint8_t type, const uint8_t *payload, uint8_t len);
+
+#endif
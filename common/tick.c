@@ -0,0 +1,69 @@
+/*
+ * File:   tick.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:20 AM
+ */
+
+#include <xc.h>
+#include "tick.h"
+
+#ifndef _XTAL_FREQ
+#define _XTAL_FREQ 20000000
+#endif
+
+#define TICK_PR2 ((_XTAL_FREQ/4/4/5/1000) - 1)
+#if TICK_PR2 > 255
+#error "Timer2 cannot produce a 1 ms tick at this _XTAL_FREQ"
+#endif
+
+static volatile uint32_t tick_ms;
+
+void tick_init(void){
+    TMR2 = 0;
+    PR2 = TICK_PR2;
+    T2CON = 0x25;      // postscale 1:5, TMR2ON, prescale 1:4
+    TMR2IF = 0;
+    TMR2IE = 1;
+    PEIE = 1;
+
+    TMR1H = 0;
+    TMR1L = 0;
+    T1CON = 0x31;      // prescale 1:8, internal clock, TMR1ON
+}
+
+void tick_isr(void){
+    TMR2IF = 0;
+    tick_ms++;
+}
+
+uint16_t tick_now(void){
+    uint16_t t;
+    TMR2IE = 0;        // two-byte read must not straddle a tick
+    t = (uint16_t)tick_ms;
+    TMR2IE = 1;
+    return t;
+}
+
+uint32_t tick_now32(void){
+    uint32_t t;
+    TMR2IE = 0;
+    t = tick_ms;
+    TMR2IE = 1;
+    return t;
+}
+
+uint16_t tick_fine(void){
+    uint8_t hi, lo;
+    do {               // re-read if the low byte rolled over between reads
+        hi = TMR1H;
+        lo = TMR1L;
+    } while(hi != TMR1H);
+    return ((uint16_t)hi << 8) | lo;
+}
+
+// 1.6 us per count: t * 8 / 5, here t * 13107 / 8192
+uint16_t tick_fine_us(uint16_t t){
+    uint32_t us = ((uint32_t)t * 13107) >> 13;
+    return us > 0xFFFF ? 0xFFFF : (uint16_t)us;
+}
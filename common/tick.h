@@ -0,0 +1,29 @@
+/*
+ * File:   tick.h
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:20 AM
+ */
+
+// 1 ms system tick from Timer2 (20 MHz: Fosc/4, 1:4 prescale, PR2 = 249,
+// 1:5 postscale). tick_isr() must be called from the interrupt handler.
+//
+// Timer1 free-runs at Fosc/4 with 1:8 prescale as a fine clock for timing
+// code: 1.6 us per count at 20 MHz, wrapping every 104.8 ms.
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <stdint.h>
+
+void tick_init(void);
+void tick_isr(void);
+
+uint16_t tick_now(void);      // ms, wraps every 65.5 s - use for intervals
+uint32_t tick_now32(void);    // ms since boot
+uint16_t tick_fine(void);     // Timer1 count
+uint16_t tick_fine_us(uint16_t t);   // Timer1 counts -> us, saturating
+
+#define TICK_FINE_US(us) ((uint16_t)((us) * 5UL / 8))   // us -> Timer1 counts at 20 MHz
+
+#endif
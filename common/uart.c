@@ -0,0 +1,146 @@
+/*
+ * File:   uart.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+#include "board.h"
+#include "uart.h"
+
+#ifndef UART_BAUD
+#define UART_BAUD 9600
+#endif
+#ifndef UART_BAUD_ERR
+#define UART_BAUD_ERR 20        // per mille: a 2 % error each end keeps within the ~4.5 % a frame allows
+#endif
+
+// Nearest divisor, Fosc/16 first
+#define UART_DIV16 ((_XTAL_FREQ / 8 / UART_BAUD + 1) / 2)
+#if UART_DIV16 <= 256
+#define UART_BRGH 1
+#define UART_DIV  UART_DIV16
+#define UART_CLK  (_XTAL_FREQ / 16)
+#else
+#define UART_BRGH 0
+#define UART_DIV  ((_XTAL_FREQ / 32 / UART_BAUD + 1) / 2)
+#define UART_CLK  (_XTAL_FREQ / 64)
+#endif
+
+#if UART_DIV < 1 || UART_DIV > 256
+#error "UART_BAUD is out of the baud rate generator's range at this _XTAL_FREQ"
+#endif
+
+#define UART_ACTUAL (UART_CLK / UART_DIV)
+#if (UART_ACTUAL > UART_BAUD ? UART_ACTUAL - UART_BAUD : UART_BAUD - UART_ACTUAL) * 1000 / UART_BAUD > UART_BAUD_ERR
+#error "UART_BAUD is more than UART_BAUD_ERR per mille off at this _XTAL_FREQ"
+#endif
+
+static uint8_t tx_buf[UART_TX_SIZE];
+static volatile uint8_t tx_head;    // written by main line
+static volatile uint8_t tx_tail;    // written by the ISR
+
+static uint8_t rx_buf[UART_RX_SIZE];
+static volatile uint8_t rx_head;    // written by the ISR
+static volatile uint8_t rx_tail;    // written by main line
+
+uint16_t uart_rx_overruns;
+uint16_t uart_rx_dropped;
+
+void uart_init(void){
+    TRISC6 = 0;   //TX output
+    TRISC7 = 1;   //RX input
+#ifdef UART_DE
+    UART_DE = 0;  //receiving
+    UART_DE_TRIS = 0;
+#endif
+    SPBRG = UART_DIV - 1;
+    BRGH = UART_BRGH;
+    SYNC = 0;
+    SPEN = 1;
+    TXEN = 1;
+    CREN = 1;
+    RCIE = 1;
+    PEIE = 1;
+}
+
+void uart_tx_isr(void){
+    if(tx_tail == tx_head){
+        TXIE = 0;     // ring drained, nothing left to send
+        return;
+    }
+    TXREG = tx_buf[tx_tail];
+    tx_tail = (tx_tail + 1) & (UART_TX_SIZE - 1);
+}
+
+uint8_t uart_tx_room(void){
+    return (UART_TX_SIZE - 1) - ((tx_head - tx_tail) & (UART_TX_SIZE - 1));
+}
+
+void uart_put(uint8_t c){
+    tx_buf[tx_head] = c;
+    tx_head = (tx_head + 1) & (UART_TX_SIZE - 1);
+#ifdef UART_DE
+    UART_DE = 1;  //after the byte is in, so uart_de_poll() cannot see an empty ring
+#endif
+    TXIE = 1;
+}
+
+// uart_put() with the room check, for an interrupt handler: its own copy,
+// so the handler shares no function with the main line
+uint8_t uart_put_isr(const uint8_t *p, uint8_t n){
+    if(n > (UART_TX_SIZE - 1) - ((tx_head - tx_tail) & (UART_TX_SIZE - 1))) return 0;
+    while(n--){
+        tx_buf[tx_head] = *p++;
+        tx_head = (tx_head + 1) & (UART_TX_SIZE - 1);
+    }
+#ifdef UART_DE
+    UART_DE = 1;
+#endif
+    TXIE = 1;
+    return 1;
+}
+
+#ifdef UART_DE
+void uart_de_poll(void){
+    if(UART_DE && tx_tail == tx_head && TRMT) UART_DE = 0;
+}
+#endif
+
+uint8_t uart_puts(const char *s){
+    uint8_t n = 0;
+    while(s[n]) n++;
+    if(n > uart_tx_room()) return 0;
+    while(*s) uart_put(*s++);
+    return 1;
+}
+
+// Empties the two-byte hardware FIFO into the ring. A full ring drops the
+// new byte rather than overwriting one a task may be reading.
+void uart_rx_isr(void){
+    while(RCIF){
+        uint8_t c = RCREG;
+        uint8_t next = (rx_head + 1) & (UART_RX_SIZE - 1);
+        if(next == rx_tail){
+            uart_rx_dropped++;
+        } else {
+            rx_buf[rx_head] = c;
+            rx_head = next;
+        }
+    }
+    if(OERR){     //overrun stops the receiver until CREN is toggled
+        CREN = 0;
+        CREN = 1;
+        uart_rx_overruns++;
+    }
+}
+
+uint8_t uart_rx_ready(void){
+    return rx_head != rx_tail;
+}
+
+uint8_t uart_rx(void){
+    uint8_t c = rx_buf[rx_tail];
+    rx_tail = (rx_tail + 1) & (UART_RX_SIZE - 1);
+    return c;
+}
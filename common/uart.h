@@ -0,0 +1,58 @@
+/*
+ * File:   uart.h
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 10:40 AM
+ */
+
+// USART on RC6/RC7 with interrupt-driven transmit and receive rings, so
+// callers queue bytes and return instead of waiting on TXIF for every
+// character, and received bytes wait in RAM until a task gets to them.
+// The interrupt handler must call uart_tx_isr() when TXIE && TXIF and
+// uart_rx_isr() when RCIE && RCIF.
+//
+// The baud rate is UART_BAUD from board.h (default 9600). uart.c picks
+// SPBRG and BRGH for it at compile time from _XTAL_FREQ, rounding to the
+// nearest divisor with BRGH = 1 (Fosc/16) where SPBRG fits 8 bits. The
+// build fails if the rate it gets is more than UART_BAUD_ERR per mille
+// off. At 20 MHz: 9600 and 19200 are 0.16 % off; 38400, 57600 and 115200
+// are 1.4 % off; 250000 is exact; 230400 cannot be made.
+//
+// With UART_DE defined (board.h: the pin and UART_DE_TRIS), queuing a byte
+// raises it to enable an RS-485 driver, and uart_de_poll(), called from
+// the tick interrupt, drops it once the ring is empty and the last stop
+// bit is out.
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+#ifndef UART_TX_SIZE
+#define UART_TX_SIZE 64   // power of two, holds one TELEM_MAX_PAYLOAD frame
+#endif
+#ifndef UART_RX_SIZE
+#define UART_RX_SIZE 16   // power of two
+#endif
+
+extern uint16_t uart_rx_overruns;   // OERR: the hardware FIFO filled before the ISR ran
+extern uint16_t uart_rx_dropped;    // bytes lost because the receive ring was full
+
+void uart_init(void);
+void uart_tx_isr(void);
+void uart_rx_isr(void);
+#ifdef UART_DE
+void uart_de_poll(void);
+#endif
+
+uint8_t uart_tx_room(void);
+void uart_put(uint8_t c);       // caller checks uart_tx_room() first
+uint8_t uart_puts(const char *s);   // queues all of s or nothing, returns 0 if it did not fit
+// Queues all n bytes or nothing from an interrupt handler; the main line
+// must not queue anything while a handler may (bus.h)
+uint8_t uart_put_isr(const uint8_t *p, uint8_t n);
+
+uint8_t uart_rx_ready(void);    // bytes waiting in the receive ring
+uint8_t uart_rx(void);          // caller checks uart_rx_ready() first
+
+#endif
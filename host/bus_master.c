@@ -0,0 +1,209 @@
+/*
+ * File:   bus_master.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 10:00 AM
+ */
+
+// RS-485 bus master for battery_sharing.c nodes (common/bus.h): polls
+// addresses first..first+n-1 in turn, one slot each, and prints what each
+// node reported and how long a scan of the fleet takes.
+//
+//   bus_master -n 8 /dev/ttyUSB0            scan nodes 1-8 once
+//   bus_master -n 32 -s 50 -q /dev/pts/3    50 scans, timing summary only
+//
+//   -b  baud rate (9600)
+//   -a  first address (1)
+//   -n  number of nodes (1)
+//   -s  number of scans (1)
+//   -w  reply timeout in ms after the poll's last byte (default: the
+//       status frame's wire time plus BUS_GAP_MS)
+//   -q  no per-node status lines
+//
+// A slot is the poll, the reply (or the timeout) and BUS_GAP_MS of
+// silence. Writes are paced to the wire time at the baud rate, so against
+// bus_nodes on a pseudo-terminal, where bytes arrive at once, the timing
+// is what a real line at that rate would give. Utilization is the bits of
+// every poll and reply over the elapsed time at the baud rate.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "frame.h"
+#include "crc.h"
+#include "serial.h"
+#include "bus.h"
+
+#define STATUS_LEN 6                     // TELEM_BATTERY: volt[4], charging, faults
+
+struct node {
+    unsigned long answered;
+    unsigned long missed;
+    double slot_sum, slot_max;           // s, poll start to end of the reply
+    uint8_t status[STATUS_LEN];
+    uint8_t len;
+};
+
+struct slot {
+    uint8_t addr;
+    int got;
+    size_t bytes;                        // reply bytes, to count them on the wire
+    struct node *node;
+};
+
+static void on_frame(const struct telem_frame *f, void *arg){
+    struct slot *s = arg;
+    if(f->type != TELEM_BATTERY || f->node != s->addr) return;
+    s->got = 1;
+    s->bytes = TELEM_FRAME_LEN(f->len);
+    s->node->len = f->len < STATUS_LEN ? f->len : STATUS_LEN;
+    memcpy(s->node->status, f->payload, s->node->len);
+}
+
+static size_t build_poll(uint8_t *buf, uint8_t addr, uint8_t seq, uint32_t ms){
+    uint16_t crc = CRC16_INIT;
+    buf[0] = TELEM_SYNC;
+    buf[1] = 0;
+    buf[2] = TELEM_POLL;
+    buf[3] = addr;
+    buf[4] = seq;
+    buf[5] = (uint8_t)ms;
+    buf[6] = (uint8_t)(ms >> 8);
+    buf[7] = (uint8_t)(ms >> 16);
+    buf[8] = (uint8_t)(ms >> 24);
+    for(int i = 1; i < TELEM_HDR_LEN; i++) crc = crc16_update(crc, buf[i]);
+    buf[9] = (uint8_t)crc;
+    buf[10] = (uint8_t)(crc >> 8);
+    return TELEM_FRAME_LEN(0);
+}
+
+// Read until the slot's reply is in or the deadline passes
+static void wait_reply(int fd, struct frame_parser *p, struct slot *s, double deadline){
+    uint8_t buf[256];
+    while(!s->got){
+        double left = deadline - serial_now();
+        if(left <= 0) return;
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int r = poll(&pfd, 1, (int)(left * 1000) + 1);
+        if(r < 0 && errno != EINTR) return;
+        if(r <= 0) continue;
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if(n <= 0) return;
+        frame_feed(p, buf, (size_t)n, on_frame, s);
+    }
+}
+
+static void print_status(uint8_t addr, const struct node *nd){
+    const uint8_t *p = nd->status;
+    printf("node %3u", addr);
+    if(!nd->answered){
+        printf("  no reply\n");
+        return;
+    }
+    for(int i = 0; i < 4 && i < nd->len; i++) printf("  B%d=%u.%uV", i + 1, p[i] / 10, p[i] % 10);
+    if(nd->len > 4){
+        if(p[4]) printf("  charging=B%u", p[4]);
+        else printf("  charging=none");
+    }
+    if(nd->len > 5) printf("  faults=0x%02X", p[5]);
+    printf("\n");
+}
+
+static void usage(const char *argv0){
+    fprintf(stderr, "usage: %s [-b baud] [-a first] [-n nodes] [-s scans] [-w ms] [-q] <device>\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    long baud = 9600;
+    int first = 1, count = 1, scans = 1, quiet = 0;
+    double timeout = -1;
+    int opt;
+
+    while((opt = getopt(argc, argv, "b:a:n:s:w:q")) != -1){
+        switch(opt){
+        case 'b': baud = strtol(optarg, NULL, 10); break;
+        case 'a': first = atoi(optarg); break;
+        case 'n': count = atoi(optarg); break;
+        case 's': scans = atoi(optarg); break;
+        case 'w': timeout = strtod(optarg, NULL) / 1000; break;
+        case 'q': quiet = 1; break;
+        default:  usage(argv[0]);
+        }
+    }
+    if(optind != argc - 1 || first < 1 || count < 1 || first + count > 256 || scans < 1)
+        usage(argv[0]);
+
+    int fd = serial_open(argv[optind], baud, O_RDWR);
+    if(fd < 0){
+        fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+        return 1;
+    }
+    if(timeout < 0) timeout = serial_wire_s(baud, TELEM_FRAME_LEN(STATUS_LEN)) + BUS_GAP_MS / 1000.0;
+
+    struct node *nodes = calloc((size_t)count, sizeof(*nodes));
+    struct frame_parser parser;
+    unsigned long bytes = 0;
+    double start = serial_now();
+    double scan_max = 0;
+    uint8_t seq = 0;
+
+    frame_parser_init(&parser);
+    for(int scan = 0; scan < scans; scan++){
+        double scan_start = serial_now();
+        for(int i = 0; i < count; i++){
+            struct slot s = { (uint8_t)(first + i), 0, 0, &nodes[i] };
+            uint8_t poll_frame[TELEM_FRAME_LEN(0)];
+            size_t n = build_poll(poll_frame, s.addr, seq++, (uint32_t)((serial_now() - start) * 1000));
+
+            double t0 = serial_now();
+            if(write(fd, poll_frame, n) != (ssize_t)n){
+                perror("write");
+                return 1;
+            }
+            tcdrain(fd);
+            double sent = t0 + serial_wire_s(baud, n);
+            serial_sleep_until(sent);
+            bytes += n;
+
+            wait_reply(fd, &parser, &s, sent + timeout);
+            double t1 = serial_now();
+            if(s.got){
+                double slot = t1 - t0;
+                nodes[i].answered++;
+                nodes[i].slot_sum += slot;
+                if(slot > nodes[i].slot_max) nodes[i].slot_max = slot;
+                bytes += s.bytes;
+            } else {
+                nodes[i].missed++;
+            }
+            serial_sleep_until(t1 + BUS_GAP_MS / 1000.0);
+        }
+        double scan_time = serial_now() - scan_start;
+        if(scan_time > scan_max) scan_max = scan_time;
+    }
+    double elapsed = serial_now() - start;
+
+    unsigned long answered = 0, missed = 0;
+    double slot_sum = 0, slot_max = 0;
+    for(int i = 0; i < count; i++){
+        if(!quiet) print_status((uint8_t)(first + i), &nodes[i]);
+        answered += nodes[i].answered;
+        missed += nodes[i].missed;
+        slot_sum += nodes[i].slot_sum;
+        if(nodes[i].slot_max > slot_max) slot_max = nodes[i].slot_max;
+    }
+    printf("%d nodes x %d scans at %ld baud: scan %.1f ms (max %.1f), %.2f ms per node, "
+           "reply slot %.2f ms (max %.2f), %lu unanswered, bus %.1f %% busy, %lu crc errors\n",
+           count, scans, baud, elapsed * 1000 / scans, scan_max * 1000,
+           elapsed * 1000 / scans / count,
+           answered ? slot_sum * 1000 / answered : 0, slot_max * 1000, missed,
+           bytes * 10.0 / baud / elapsed * 100, parser.crc_errors);
+    free(nodes);
+    return missed ? 3 : 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * File:   bus_nodes.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 10:00 AM
+ */
+
+// A fleet of virtual battery_sharing.c bus nodes for bus_master: opens a
+// pseudo-terminal, prints the path of its slave end, and answers polls
+// (common/bus.h) for addresses first..first+n-1 until killed.
+//
+//   bus_nodes -n 32 &            prints e.g. /dev/pts/3
+//   bus_master -n 32 -s 20 -q /dev/pts/3
+//
+//   -b  baud rate the replies are paced at (9600)
+//   -a  first address (1)
+//   -n  number of nodes (1)
+//   -r  reply start after the poll's last byte, us (20: the firmware
+//       answers from its receive interrupt)
+//   -l  percentage of polls left unanswered, to exercise timeouts
+//
+// A pseudo-terminal moves bytes at once, so each reply is held back for
+// the poll's and its own wire time at the baud rate, and the master sees
+// it when a real line would have delivered its last byte. Each node's
+// packs drift between 11.5 and 14.5 V; the lowest below 13.8 V charges.
+
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "frame.h"
+#include "crc.h"
+#include "serial.h"
+
+#define FULL_VOLT 138
+#define LOW_VOLT  122
+
+struct fleet {
+    int fd;
+    long baud;
+    int first, count;
+    double reply_s;
+    int loss;
+    double poll_end;                     // wire time of the poll being answered
+    uint8_t (*volt)[4];
+    uint8_t seq;
+    double start;
+    unsigned long polls, answered;
+};
+
+static size_t build_status(struct fleet *fl, uint8_t *buf, uint8_t addr){
+    uint8_t *v = fl->volt[addr - fl->first];
+    uint8_t charging = 0, faults = 0;
+    uint32_t ms = (uint32_t)((serial_now() - fl->start) * 1000);
+    uint16_t crc = CRC16_INIT;
+
+    for(int i = 0; i < 4; i++){
+        int d = rand() % 3 - 1;          // random walk, 0.1 V steps
+        if(v[i] + d >= 115 && v[i] + d <= 145) v[i] += d;
+        if(v[i] < FULL_VOLT && (!charging || v[i] < v[charging - 1])) charging = (uint8_t)(i + 1);
+        if(v[i] < LOW_VOLT) faults |= BATT_LOW;
+    }
+    buf[0] = TELEM_SYNC;
+    buf[1] = 6;
+    buf[2] = TELEM_BATTERY;
+    buf[3] = addr;
+    buf[4] = fl->seq++;
+    buf[5] = (uint8_t)ms;
+    buf[6] = (uint8_t)(ms >> 8);
+    buf[7] = (uint8_t)(ms >> 16);
+    buf[8] = (uint8_t)(ms >> 24);
+    memcpy(buf + 9, v, 4);
+    buf[13] = charging;
+    buf[14] = faults;
+    for(int i = 1; i < 15; i++) crc = crc16_update(crc, buf[i]);
+    buf[15] = (uint8_t)crc;
+    buf[16] = (uint8_t)(crc >> 8);
+    return TELEM_FRAME_LEN(6);
+}
+
+static void on_frame(const struct telem_frame *f, void *arg){
+    struct fleet *fl = arg;
+    uint8_t buf[TELEM_FRAME_LEN(6)];
+
+    if(f->type != TELEM_POLL || f->node < fl->first || f->node >= fl->first + fl->count) return;
+    fl->polls++;
+    if(rand() % 100 < fl->loss) return;
+
+    size_t n = build_status(fl, buf, f->node);
+    serial_sleep_until(fl->poll_end + fl->reply_s + serial_wire_s(fl->baud, n));
+    if(write(fl->fd, buf, n) == (ssize_t)n) fl->answered++;
+}
+
+static void usage(const char *argv0){
+    fprintf(stderr, "usage: %s [-b baud] [-a first] [-n nodes] [-r us] [-l percent]\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    struct fleet fl;
+    int opt;
+
+    memset(&fl, 0, sizeof(fl));
+    fl.baud = 9600;
+    fl.first = 1;
+    fl.count = 1;
+    fl.reply_s = 20e-6;
+    while((opt = getopt(argc, argv, "b:a:n:r:l:")) != -1){
+        switch(opt){
+        case 'b': fl.baud = strtol(optarg, NULL, 10); break;
+        case 'a': fl.first = atoi(optarg); break;
+        case 'n': fl.count = atoi(optarg); break;
+        case 'r': fl.reply_s = strtod(optarg, NULL) / 1e6; break;
+        case 'l': fl.loss = atoi(optarg); break;
+        default:  usage(argv[0]);
+        }
+    }
+    if(optind != argc || fl.first < 1 || fl.count < 1 || fl.first + fl.count > 256 || fl.baud <= 0)
+        usage(argv[0]);
+
+    fl.fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if(fl.fd < 0 || grantpt(fl.fd) < 0 || unlockpt(fl.fd) < 0){
+        perror("posix_openpt");
+        return 1;
+    }
+    // Hold the slave end open in raw mode, so the master may come and go
+    const char *name = ptsname(fl.fd);
+    int slave = serial_open(name, 9600, O_RDWR);
+    if(slave < 0){
+        perror(name);
+        return 1;
+    }
+    printf("%s\n", name);
+    fflush(stdout);
+
+    fl.volt = malloc((size_t)fl.count * sizeof(*fl.volt));
+    for(int i = 0; i < fl.count; i++){
+        for(int j = 0; j < 4; j++) fl.volt[i][j] = (uint8_t)(120 + rand() % 20);
+    }
+    fl.start = serial_now();
+
+    struct frame_parser parser;
+    uint8_t buf[256];
+    ssize_t n;
+    frame_parser_init(&parser);
+    while((n = read(fl.fd, buf, sizeof(buf))) > 0){
+        // The whole poll came in one write; on the wire it ends one poll
+        // frame after its first byte
+        fl.poll_end = serial_now() + serial_wire_s(fl.baud, TELEM_FRAME_LEN(0));
+        frame_feed(&parser, buf, (size_t)n, on_frame, &fl);
+    }
+    fprintf(stderr, "%lu polls, %lu answered, %lu crc errors\n", fl.polls, fl.answered, parser.crc_errors);
+    return 0;
+}
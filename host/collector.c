@@ -0,0 +1,268 @@
+/*
+ * File:   collector.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 2:30 PM
+ */
+
+// Collects telemetry from many boards at once. Every link (serial port,
+// pseudo-terminal, FIFO) is read through one epoll loop and decoded in
+// place by frame_feed(), and each frame is appended to the columnar log of
+// its board (collog.h): <dir>/<link>-n<node>.col, where link is the
+// device's base name, so the boards on one RS-485 link each get a log.
+//
+//   collector -o logs /dev/ttyUSB0 /dev/ttyUSB1
+//   collector -b 115200 -t 60 -i 5 -o logs /dev/pts/3 /dev/pts/4
+//   collector -d logs/ttyUSB0-n1.col         print a log as CSV
+//
+//   -b  baud rate of serial ports (9600)
+//   -o  directory for the logs (.)
+//   -t  stop after this many seconds (default: until SIGINT or SIGTERM)
+//   -i  print a rate line every this many seconds
+//   -d  print a log as CSV and exit
+//
+// A link that hangs up is dropped and the rest carry on. On exit it prints
+// the frames, frames/s, bytes, CRC errors and CPU time (user + system)
+// as a share of one core.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "frame.h"
+#include "collog.h"
+#include "serial.h"
+
+struct link {
+    int fd;
+    const char *path;
+    const char *name;            // base name, for the log files
+    struct frame_parser parser;
+    struct collog *logs[256];    // per node, opened on its first frame
+    uint64_t recv_ns;            // when the current read came in
+    unsigned long bytes;
+};
+
+static const char *log_dir = ".";
+static volatile sig_atomic_t stop;
+static unsigned long boards;
+static unsigned long log_errors;
+
+static void on_signal(int sig){
+    (void)sig;
+    stop = 1;
+}
+
+static uint64_t realtime_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static double cpu_s(void){
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+           ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+static void on_frame(const struct telem_frame *f, void *arg){
+    struct link *ln = arg;
+    struct collog *l = ln->logs[f->node];
+
+    if(!l){
+        char path[512];
+        l = malloc(sizeof(*l));
+        snprintf(path, sizeof(path), "%s/%s-n%u.col", log_dir, ln->name, f->node);
+        if(!l || collog_open(l, path, f->node) < 0){
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            free(l);
+            log_errors++;
+            return;
+        }
+        ln->logs[f->node] = l;
+        boards++;
+    }
+    if(collog_append(l, f, ln->recv_ns) < 0) log_errors++;
+}
+
+static void close_link(struct link *ln){
+    close(ln->fd);
+    ln->fd = -1;
+    for(int i = 0; i < 256; i++){
+        if(!ln->logs[i]) continue;
+        collog_close(ln->logs[i]);
+        free(ln->logs[i]);
+        ln->logs[i] = NULL;
+    }
+}
+
+static void totals(struct link *links, int n, unsigned long *frames, unsigned long *bytes,
+                   unsigned long *crc){
+    *frames = *bytes = *crc = 0;
+    for(int i = 0; i < n; i++){
+        *frames += links[i].parser.frames;
+        *bytes += links[i].bytes;
+        *crc += links[i].parser.crc_errors;
+    }
+}
+
+// -d: one CSV line per row, the payload in hex
+static int dump(const char *path){
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) < 0){
+        perror(path);
+        return 1;
+    }
+    if(st.st_size < COLLOG_HDR_BYTES){
+        fprintf(stderr, "%s: not a collector log\n", path);
+        return 1;
+    }
+    const uint8_t *m = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if(m == MAP_FAILED){
+        perror(path);
+        return 1;
+    }
+    const struct collog_header *h = (const void *)m;
+    if(memcmp(h->magic, COLLOG_MAGIC, 8) || h->version != COLLOG_VERSION ||
+       h->block_rows != COLLOG_BLOCK_ROWS || h->payload_width != TELEM_MAX_PAYLOAD){
+        fprintf(stderr, "%s: not a collector log\n", path);
+        return 1;
+    }
+    uint64_t rows = h->rows;
+    uint64_t room = (uint64_t)(st.st_size - COLLOG_HDR_BYTES) / COLLOG_BLOCK_BYTES * COLLOG_BLOCK_ROWS;
+    if(rows > room) rows = room;
+
+    printf("recv_ns,node,tick_ms,seq,type,payload\n");
+    for(uint64_t row = 0; row < rows; row++){
+        const uint8_t *b = m + COLLOG_HDR_BYTES + (row / COLLOG_BLOCK_ROWS) * COLLOG_BLOCK_BYTES;
+        uint32_t r = (uint32_t)(row % COLLOG_BLOCK_ROWS);
+        uint8_t len = b[COLLOG_LEN + r];
+        const uint8_t *p = b + COLLOG_PAYLOAD + (size_t)r * TELEM_MAX_PAYLOAD;
+        printf("%llu,%u,%u,%u,%u,", (unsigned long long)((const uint64_t *)(b + COLLOG_RECV_NS))[r],
+               h->node, ((const uint32_t *)(b + COLLOG_TICK))[r], b[COLLOG_SEQ + r], b[COLLOG_TYPE + r]);
+        for(int i = 0; i < len && i < TELEM_MAX_PAYLOAD; i++) printf("%02X", p[i]);
+        printf("\n");
+    }
+    return 0;
+}
+
+static void usage(const char *argv0){
+    fprintf(stderr, "usage: %s [-b baud] [-o dir] [-t seconds] [-i seconds] <link>...\n"
+                    "       %s -d <log.col>\n", argv0, argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    long baud = 9600;
+    double run_for = 0, interval = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "b:o:t:i:d:")) != -1){
+        switch(opt){
+        case 'b': baud = strtol(optarg, NULL, 10); break;
+        case 'o': log_dir = optarg; break;
+        case 't': run_for = strtod(optarg, NULL); break;
+        case 'i': interval = strtod(optarg, NULL); break;
+        case 'd': return dump(optarg);
+        default:  usage(argv[0]);
+        }
+    }
+    int nlinks = argc - optind;
+    if(nlinks < 1) usage(argv[0]);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    int ep = epoll_create1(0);
+    struct link *links = calloc((size_t)nlinks, sizeof(*links));
+    int open_links = 0;
+    for(int i = 0; i < nlinks; i++){
+        struct link *ln = &links[i];
+        const char *slash = strrchr(argv[optind + i], '/');
+        ln->path = argv[optind + i];
+        ln->name = slash ? slash + 1 : ln->path;
+        frame_parser_init(&ln->parser);
+        ln->fd = serial_open(ln->path, baud, O_RDONLY | O_NONBLOCK);
+        if(ln->fd < 0){
+            fprintf(stderr, "%s: %s\n", ln->path, strerror(errno));
+            continue;
+        }
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = ln };
+        epoll_ctl(ep, EPOLL_CTL_ADD, ln->fd, &ev);
+        open_links++;
+    }
+
+    static uint8_t buf[65536];
+    double start = serial_now(), cpu_start = cpu_s();
+    double next_report = start + interval;
+    unsigned long last_frames = 0;
+
+    while(!stop && open_links){
+        double now = serial_now();
+        double wait = 1.0;
+        if(run_for > 0){
+            if(now - start >= run_for) break;
+            if(start + run_for - now < wait) wait = start + run_for - now;
+        }
+        if(interval > 0){
+            if(now >= next_report){
+                unsigned long frames, bytes, crc;
+                totals(links, nlinks, &frames, &bytes, &crc);
+                printf("%8.1fs %10lu frames %9.0f/s %6lu boards %6lu crc errors\n", now - start,
+                       frames, (frames - last_frames) / interval, boards, crc);
+                fflush(stdout);
+                last_frames = frames;
+                next_report += interval;
+            }
+            if(next_report - now < wait) wait = next_report - now;
+        }
+
+        struct epoll_event ev[64];
+        int n = epoll_wait(ep, ev, 64, (int)(wait * 1000) + 1);
+        if(n < 0 && errno != EINTR){
+            perror("epoll_wait");
+            break;
+        }
+        for(int i = 0; i < n; i++){
+            struct link *ln = ev[i].data.ptr;
+            ssize_t r = read(ln->fd, buf, sizeof(buf));
+            if(r > 0){
+                ln->recv_ns = realtime_ns();
+                ln->bytes += (unsigned long)r;
+                frame_feed(&ln->parser, buf, (size_t)r, on_frame, ln);
+            } else if(r == 0 || (errno != EAGAIN && errno != EINTR)){
+                fprintf(stderr, "%s: %s\n", ln->path, r == 0 ? "closed" : strerror(errno));
+                epoll_ctl(ep, EPOLL_CTL_DEL, ln->fd, NULL);
+                close_link(ln);
+                open_links--;
+            }
+        }
+    }
+
+    double elapsed = serial_now() - start;
+    double cpu = cpu_s() - cpu_start;
+    unsigned long frames, bytes, crc;
+    totals(links, nlinks, &frames, &bytes, &crc);
+    for(int i = 0; i < nlinks; i++){
+        if(links[i].fd >= 0) close_link(&links[i]);
+    }
+    printf("%d links, %lu boards: %lu frames in %.1f s, %.0f frames/s, %.2f MB/s, "
+           "%lu crc errors, %lu log errors, cpu %.1f %%\n",
+           nlinks, boards, frames, elapsed, frames / elapsed, bytes / elapsed / 1e6,
+           crc, log_errors, cpu / elapsed * 100);
+    free(links);
+    return 0;
+}
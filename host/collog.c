@@ -0,0 +1,94 @@
+/*
+ * File:   collog.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 2:00 PM
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "collog.h"
+
+static off_t block_offset(uint64_t n){
+    return COLLOG_HDR_BYTES + (off_t)n * COLLOG_BLOCK_BYTES;
+}
+
+// Map block n, growing the file to hold it; the new pages read as zeros
+static int map_block(struct collog *l, uint64_t n){
+    if(l->block) munmap(l->block, COLLOG_BLOCK_BYTES);
+    l->block = NULL;
+    struct stat st;
+    if(fstat(l->fd, &st) < 0) return -1;
+    if(st.st_size < block_offset(n + 1) && ftruncate(l->fd, block_offset(n + 1)) < 0) return -1;
+    void *p = mmap(NULL, COLLOG_BLOCK_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, l->fd, block_offset(n));
+    if(p == MAP_FAILED) return -1;
+    l->block = p;
+    l->block_no = n;
+    return 0;
+}
+
+int collog_open(struct collog *l, const char *path, uint8_t node){
+    memset(l, 0, sizeof(*l));
+    l->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(l->fd < 0) return -1;
+
+    struct stat st;
+    if(fstat(l->fd, &st) < 0) goto fail;
+    int fresh = st.st_size == 0;
+    if(fresh && ftruncate(l->fd, COLLOG_HDR_BYTES) < 0) goto fail;
+    void *p = mmap(NULL, COLLOG_HDR_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, l->fd, 0);
+    if(p == MAP_FAILED) goto fail;
+    l->hdr = p;
+
+    if(fresh){
+        memcpy(l->hdr->magic, COLLOG_MAGIC, 8);
+        l->hdr->version = COLLOG_VERSION;
+        l->hdr->block_rows = COLLOG_BLOCK_ROWS;
+        l->hdr->payload_width = TELEM_MAX_PAYLOAD;
+        l->hdr->node = node;
+    } else if(memcmp(l->hdr->magic, COLLOG_MAGIC, 8) || l->hdr->version != COLLOG_VERSION ||
+              l->hdr->block_rows != COLLOG_BLOCK_ROWS || l->hdr->payload_width != TELEM_MAX_PAYLOAD ||
+              l->hdr->node != node){
+        errno = EINVAL;
+        goto fail;
+    }
+    if(map_block(l, l->hdr->rows / COLLOG_BLOCK_ROWS) < 0) goto fail;
+    return 0;
+
+fail:
+    {
+        int e = errno;
+        collog_close(l);
+        errno = e;
+    }
+    return -1;
+}
+
+int collog_append(struct collog *l, const struct telem_frame *f, uint64_t recv_ns){
+    uint64_t row = l->hdr->rows;
+    if(row / COLLOG_BLOCK_ROWS != l->block_no && map_block(l, row / COLLOG_BLOCK_ROWS) < 0) return -1;
+
+    uint32_t r = (uint32_t)(row % COLLOG_BLOCK_ROWS);
+    uint8_t *b = l->block;
+    ((uint64_t *)(b + COLLOG_RECV_NS))[r] = recv_ns;
+    ((uint32_t *)(b + COLLOG_TICK))[r] = f->tick;
+    b[COLLOG_TYPE + r] = f->type;
+    b[COLLOG_SEQ + r] = f->seq;
+    b[COLLOG_LEN + r] = f->len;
+    memcpy(b + COLLOG_PAYLOAD + (size_t)r * TELEM_MAX_PAYLOAD, f->payload, f->len);
+    l->hdr->rows = row + 1;
+    return 0;
+}
+
+void collog_close(struct collog *l){
+    if(l->block) munmap(l->block, COLLOG_BLOCK_BYTES);
+    if(l->hdr) munmap(l->hdr, COLLOG_HDR_BYTES);
+    if(l->fd >= 0) close(l->fd);
+    l->block = NULL;
+    l->hdr = NULL;
+    l->fd = -1;
+}
@@ -0,0 +1,65 @@
+/*
+ * File:   collog.h
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 2:00 PM
+ */
+
+// Columnar log of telemetry frames for one board, written through mmap.
+// The file is a one-page header, then blocks of COLLOG_BLOCK_ROWS rows,
+// each block column by column:
+//
+//   recv_ns  u64[rows]   host CLOCK_REALTIME when the read holding the frame returned
+//   tick     u32[rows]   board ms since boot
+//   type     u8[rows]
+//   seq      u8[rows]
+//   len      u8[rows]
+//   payload  u8[rows][TELEM_MAX_PAYLOAD], unused bytes zero
+//
+// so a reader maps the file and scans one column (every tick, every
+// battery voltage) without touching the others. Numbers are host byte
+// order. The header's row count is updated after each row is complete;
+// rows past it are not valid. Opening an existing log appends to it.
+
+#ifndef COLLOG_H
+#define COLLOG_H
+
+#include <stdint.h>
+#include "frame.h"
+
+#define COLLOG_MAGIC      "TELEMCOL"
+#define COLLOG_VERSION    1
+#define COLLOG_HDR_BYTES  4096
+#define COLLOG_BLOCK_ROWS 4096
+
+struct collog_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t block_rows;
+    uint32_t payload_width;
+    uint32_t node;
+    uint64_t rows;
+};
+
+// Column offsets within a block
+#define COLLOG_RECV_NS  0
+#define COLLOG_TICK     (COLLOG_RECV_NS + 8 * COLLOG_BLOCK_ROWS)
+#define COLLOG_TYPE     (COLLOG_TICK + 4 * COLLOG_BLOCK_ROWS)
+#define COLLOG_SEQ      (COLLOG_TYPE + COLLOG_BLOCK_ROWS)
+#define COLLOG_LEN      (COLLOG_SEQ + COLLOG_BLOCK_ROWS)
+#define COLLOG_PAYLOAD  (COLLOG_LEN + COLLOG_BLOCK_ROWS)
+#define COLLOG_BLOCK_BYTES (COLLOG_PAYLOAD + TELEM_MAX_PAYLOAD * COLLOG_BLOCK_ROWS)
+
+struct collog {
+    int fd;
+    struct collog_header *hdr;   // mapped
+    uint8_t *block;              // mapped block holding row hdr->rows
+    uint64_t block_no;
+};
+
+// 0, or -1 with errno set (EINVAL: not a log, or one for another node)
+int collog_open(struct collog *l, const char *path, uint8_t node);
+int collog_append(struct collog *l, const struct telem_frame *f, uint64_t recv_ns);
+void collog_close(struct collog *l);
+
+#endif
@@ -0,0 +1,45 @@
+#!/bin/sh
+# Scan time and bus utilization as an RS-485 fleet grows: for each rate
+# and fleet size, bus_nodes answers for n virtual nodes on a
+# pseudo-terminal and bus_master polls them (see bus_master.c):
+#
+#   host/fleet.sh [-b "rates"] [-n "sizes"] [-s scans]
+#
+#   -b  baud rates (default "9600 115200")
+#   -n  fleet sizes (default "1 2 4 8 16 32 64")
+#   -s  scans per run (default 5)
+#
+# Run from host/ after make bus_master bus_nodes.
+
+RATES="9600 115200"
+SIZES="1 2 4 8 16 32 64"
+SCANS=5
+
+while getopts b:n:s: opt; do
+    case $opt in
+    b) RATES=$OPTARG ;;
+    n) SIZES=$OPTARG ;;
+    s) SCANS=$OPTARG ;;
+    *) sed -n '2,12s/^# \{0,1\}//p' "$0" >&2; exit 2 ;;
+    esac
+done
+
+TMP=$(mktemp)
+trap 'rm -f "$TMP"; kill $NODES 2>/dev/null' EXIT
+
+printf "%7s %6s %10s %10s %10s %8s %8s\n" baud nodes "scan ms" "ms/node" "slot ms" "busy %" missed
+for b in $RATES; do
+    for n in $SIZES; do
+        ./bus_nodes -b $b -n $n >"$TMP" 2>/dev/null &
+        NODES=$!
+        while [ ! -s "$TMP" ]; do sleep 0.05; done
+        ./bus_master -b $b -n $n -s $SCANS -q "$(cat "$TMP")" |
+            sed -n 's/.*scan \([0-9.]*\) ms.*, \([0-9.]*\) ms per node, reply slot \([0-9.]*\) ms.*, \([0-9]*\) unanswered, bus \([0-9.]*\) % busy.*/\1 \2 \3 \5 \4/p' |
+            while read scan per slot busy missed; do
+                printf "%7s %6s %10s %10s %10s %8s %8s\n" $b $n $scan $per $slot $busy $missed
+            done
+        kill $NODES
+        wait $NODES 2>/dev/null
+        : >"$TMP"
+    done
+done
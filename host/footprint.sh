@@ -0,0 +1,76 @@
+#!/bin/sh
+# Flash and RAM used by each firmware, built with XC8 for the PIC16F877A
+# from the same source lists the simulators use (the sim_<board>
+# prerequisites in host/Makefile):
+#
+#   host/footprint.sh [-r rev] [-D macro]...
+#
+#   -r  also build git revision rev (e.g. the commit before the shared
+#       drivers) in a temporary worktree and print the difference
+#   -D  extra project-wide define, e.g. -D PROBES
+#
+# Needs xc8-cc (XC8 2.x) on PATH, or XC8=/path/to/xc8-cc.
+
+XC8=${XC8:-xc8-cc}
+BOARDS="battery temp clock rtc rfid calc"
+REV=
+DEFS=
+
+while getopts r:D: opt; do
+    case $opt in
+    r) REV=$OPTARG ;;
+    D) DEFS="$DEFS -D$OPTARG" ;;
+    *) sed -n '2,13s/^# \{0,1\}//p' "$0" >&2; exit 2 ;;
+    esac
+done
+
+if ! command -v "$XC8" >/dev/null 2>&1; then
+    echo "footprint: $XC8 not found (set XC8=)" >&2
+    exit 2
+fi
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"; [ -n "$REV" ] && git -C "$ROOT" worktree remove --force "$TMP/rev" 2>/dev/null' EXIT
+
+# build <tree> <board> -> "words bytes", or "- -" if it did not build
+build() {
+    srcs=$(make -C "$1/host" -pq "sim_$2" 2>/dev/null | sed -n "s/^sim_$2: //p" |
+           tr ' ' '\n' | grep '\.c$' | grep -v '^sim/')
+    inc=
+    [ -d "$1/boards/$2" ] && inc="-I../boards/$2"
+    out=$(cd "$1/host" && "$XC8" -mcpu=16F877A -O2 -I.. $inc $DEFS \
+          -o "$TMP/$2.elf" $srcs 2>&1)
+    words=$(echo "$out" | sed -n 's/.*Program space *used *[0-9A-Fa-f]*h *( *\([0-9]*\)).*/\1/p')
+    bytes=$(echo "$out" | sed -n 's/.*Data space *used *[0-9A-Fa-f]*h *( *\([0-9]*\)).*/\1/p')
+    if [ -z "$words" ]; then
+        echo "$out" | grep -i error | head -3 >&2
+        echo "- -"
+    else
+        echo "$words $bytes"
+    fi
+}
+
+if [ -n "$REV" ]; then
+    git -C "$ROOT" worktree add --detach "$TMP/rev" "$REV" >/dev/null 2>&1 || {
+        echo "footprint: cannot check out $REV" >&2
+        exit 2
+    }
+    printf "%-8s %12s %10s   %12s %10s   %8s %8s\n" board "flash words" "RAM bytes" \
+        "$REV words" "RAM bytes" "d flash" "d RAM"
+else
+    printf "%-8s %12s %10s\n" board "flash words" "RAM bytes"
+fi
+
+for b in $BOARDS; do
+    set -- $(build "$ROOT" $b)
+    if [ -z "$REV" ]; then
+        printf "%-8s %12s %10s\n" $b $1 $2
+        continue
+    fi
+    w=$1 r=$2
+    set -- $(build "$TMP/rev" $b)
+    dw=- dr=-
+    [ "$w" != - ] && [ "$1" != - ] && dw=$((w - $1)) && dr=$((r - $2))
+    printf "%-8s %12s %10s   %12s %10s   %8s %8s\n" $b $w $r $1 $2 $dw $dr
+done
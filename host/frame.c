@@ -0,0 +1,88 @@
+/*
+ * File:   frame.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 11:30 AM
+ */
+
+#include <string.h>
+#include "frame.h"
+#include "crc.h"
+
+void frame_parser_init(struct frame_parser *p){
+    memset(p, 0, sizeof(*p));
+}
+
+// Check a complete candidate at buf. Returns its length when valid,
+// 0 when more bytes are needed, -1 when buf[0] does not start a frame.
+static long frame_check(struct frame_parser *p, const uint8_t *buf, size_t n,
+                        frame_cb cb, void *ctx){
+    if(n < 2) return 0;
+    uint8_t len = buf[1];
+    if(len > TELEM_MAX_PAYLOAD) return -1;
+    size_t total = TELEM_FRAME_LEN(len);
+    if(n < total) return 0;
+
+    uint16_t crc = CRC16_INIT;
+    for(size_t i = 1; i < total - TELEM_CRC_LEN; i++){
+        crc = crc16_update(crc, buf[i]);
+    }
+    if((uint8_t)crc != buf[total - 2] || (uint8_t)(crc >> 8) != buf[total - 1]){
+        p->crc_errors++;
+        return -1;
+    }
+
+    struct telem_frame f;
+    f.len = len;
+    f.type = buf[2];
+    f.node = buf[3];
+    f.seq = buf[4];
+    f.tick = (uint32_t)buf[5] | ((uint32_t)buf[6] << 8) |
+             ((uint32_t)buf[7] << 16) | ((uint32_t)buf[8] << 24);
+    f.payload = buf + TELEM_HDR_LEN;
+    p->frames++;
+    cb(&f, ctx);
+    return (long)total;
+}
+
+void frame_feed(struct frame_parser *p, const uint8_t *data, size_t n,
+                frame_cb cb, void *ctx){
+    // Finish a frame split across reads: top up part[] one byte at a time
+    // until it resolves, then continue on the caller's buffer.
+    while(p->have && n){
+        p->part[p->have++] = *data++;
+        n--;
+        long r = frame_check(p, p->part, p->have, cb, ctx);
+        if(r > 0){
+            p->have = 0;
+        } else if(r < 0){
+            // Not a frame after all: rescan what we held, minus the SYNC
+            size_t held = p->have - 1;
+            uint8_t tmp[sizeof(p->part)];
+            memcpy(tmp, p->part + 1, held);
+            p->have = 0;
+            p->skipped++;
+            frame_feed(p, tmp, held, cb, ctx);
+        }
+    }
+
+    size_t i = 0;
+    while(i < n){
+        if(data[i] != TELEM_SYNC){
+            p->skipped++;
+            i++;
+            continue;
+        }
+        long r = frame_check(p, data + i, n - i, cb, ctx);
+        if(r > 0){
+            i += (size_t)r;
+        } else if(r < 0){
+            p->skipped++;
+            i++;
+        } else {
+            p->have = n - i;
+            memcpy(p->part, data + i, p->have);
+            return;
+        }
+    }
+}
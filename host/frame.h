@@ -0,0 +1,42 @@
+/*
+ * File:   frame.h
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 11:30 AM
+ */
+
+// Incremental parser for the telemetry frames in common/telemetry.h.
+// Frames that lie entirely inside the buffer handed to frame_feed() are
+// reported in place; only a frame split across two reads is copied.
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "telemetry.h"
+
+struct telem_frame {
+    uint8_t len;
+    uint8_t type;
+    uint8_t node;
+    uint8_t seq;
+    uint32_t tick;
+    const uint8_t *payload;
+};
+
+typedef void (*frame_cb)(const struct telem_frame *f, void *ctx);
+
+struct frame_parser {
+    uint8_t part[TELEM_FRAME_LEN(TELEM_MAX_PAYLOAD)];
+    size_t have;                 // bytes of a split frame held in part[]
+    unsigned long frames;
+    unsigned long crc_errors;
+    unsigned long skipped;       // bytes dropped while hunting for SYNC
+};
+
+void frame_parser_init(struct frame_parser *p);
+void frame_feed(struct frame_parser *p, const uint8_t *data, size_t n,
+                frame_cb cb, void *ctx);
+
+#endif
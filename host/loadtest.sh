@@ -0,0 +1,45 @@
+#!/bin/sh
+# Collector load test: for each board count, telem_gen streams frames into
+# that many pseudo-terminals and collector logs them for a few seconds,
+# then frames/s, MB/s and the collector's CPU share are printed.
+#
+#   host/loadtest.sh [-n "counts"] [-r rate] [-t seconds]
+#
+#   -n  board counts (default "1 4 16 64 256")
+#   -r  frames/s per board (default: as fast as the collector takes them)
+#   -t  seconds per run (default 3)
+#
+# Run from host/ after make collector telem_gen. The logs go to a
+# temporary directory that is removed afterwards.
+
+COUNTS="1 4 16 64 256"
+RATE=
+SECS=3
+
+while getopts n:r:t: opt; do
+    case $opt in
+    n) COUNTS=$OPTARG ;;
+    r) RATE="-r $OPTARG" ;;
+    t) SECS=$OPTARG ;;
+    *) sed -n '2,13s/^# \{0,1\}//p' "$0" >&2; exit 2 ;;
+    esac
+done
+
+TMP=$(mktemp -d)
+trap 'kill $GEN 2>/dev/null; rm -rf "$TMP"' EXIT
+
+printf "%7s %12s %10s %10s %8s\n" boards "frames/s" "MB/s" "cpu %" "crc err"
+for n in $COUNTS; do
+    ./telem_gen -n $n $RATE >"$TMP/paths" &
+    GEN=$!
+    while [ $(wc -l <"$TMP/paths") -lt $n ]; do sleep 0.05; done
+    mkdir "$TMP/logs"
+    ./collector -t $SECS -o "$TMP/logs" $(cat "$TMP/paths") |
+        sed -n 's/.* \([0-9]*\) frames\/s, \([0-9.]*\) MB\/s, \([0-9]*\) crc errors.*cpu \([0-9.]*\) %.*/\1 \2 \4 \3/p' |
+        while read fps mbs cpu crc; do
+            printf "%7s %12s %10s %10s %8s\n" $n $fps $mbs $cpu $crc
+        done
+    kill $GEN
+    wait $GEN 2>/dev/null
+    rm -rf "$TMP/logs"
+done
@@ -0,0 +1,62 @@
+/*
+ * File:   serial.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 9:30 AM
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "serial.h"
+
+static speed_t baud_const(long baud){
+    switch(baud){
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    default:     return 0;
+    }
+}
+
+int serial_open(const char *path, long baud, int flags){
+    int fd = open(path, flags | O_NOCTTY);
+    if(fd < 0) return -1;
+    if(isatty(fd)){
+        struct termios tio;
+        speed_t sp = baud_const(baud);
+        if(!sp || tcgetattr(fd, &tio) < 0){
+            close(fd);
+            errno = EINVAL;
+            return -1;
+        }
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, sp);
+        cfsetospeed(&tio, sp);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+double serial_wire_s(long baud, size_t n){
+    return n * 10.0 / baud;
+}
+
+double serial_now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void serial_sleep_until(double t){
+    struct timespec ts = { (time_t)t, (long)((t - (time_t)t) * 1e9) };
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
@@ -0,0 +1,26 @@
+/*
+ * File:   serial.h
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 9:30 AM
+ */
+
+// Serial ports for the host tools: raw 8N1 at a standard rate. Anything
+// that is not a terminal (a capture file, a pipe) is opened as it is.
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include <stddef.h>
+
+// open(2) flags as usual; -1 with errno set, EINVAL for an unknown rate
+int serial_open(const char *path, long baud, int flags);
+
+// Time n bytes take on the wire at baud, 10 bits each
+double serial_wire_s(long baud, size_t n);
+
+// Seconds on CLOCK_MONOTONIC, and a sleep until a time on it
+double serial_now(void);
+void serial_sleep_until(double t);
+
+#endif
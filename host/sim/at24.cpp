@@ -0,0 +1,58 @@
+/*
+ * File:   at24.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 2:00 PM
+ */
+
+#include "at24.h"
+
+namespace sim {
+
+const double AT24_WRITE_MS = 5;
+
+At24::At24(Pic &p, size_t size, size_t pg) : mem(size, 0xFF), pic(p), page(pg)
+{
+}
+
+void At24::start(bool read)
+{
+    addr_left = read ? 0 : 2;
+    latched = 0;
+    latch.clear();
+}
+
+bool At24::write(uint8_t b)
+{
+    if (addr_left) {
+        ptr = (addr_left == 2 ? (size_t)b << 8 : (ptr & 0xFF00) | b) & (mem.size() - 1);
+        addr_left--;
+        return true;
+    }
+    if (latched++ == page)
+        pic.violation("24C32", "page write longer than a page wrapped to the page start");
+    latch.push_back({ ptr, b });
+    ptr = (ptr & ~(page - 1)) | ((ptr + 1) & (page - 1));
+    return true;
+}
+
+uint8_t At24::read()
+{
+    uint8_t v = mem[ptr];
+    ptr = (ptr + 1) & (mem.size() - 1);
+    return v;
+}
+
+void At24::stop()
+{
+    if (latch.empty())
+        return;
+    for (auto &w : latch)
+        mem[w.first] = w.second;
+    bytes_written += latch.size();
+    page_writes++;
+    latch.clear();
+    write_done = pic.now + from_ms(AT24_WRITE_MS);
+}
+
+} // namespace sim
@@ -0,0 +1,49 @@
+/*
+ * File:   at24.h
+ * Author: Rakesh B
+ *
+ * Created on October 25, 2026, 2:00 PM
+ */
+
+// 24C32 I2C EEPROM at 0x50: 4096 bytes behind two address bytes, 32-byte
+// pages. Data bytes go into the page latch and are programmed at STOP,
+// taking tWR = 5 ms during which the chip does not acknowledge its
+// address (ACK polling). Bytes written past the end of a page wrap to its
+// start, as in the datasheet, and are reported; reads auto-increment
+// across the whole array. A new chip reads 0xFF.
+
+#ifndef SIM_AT24_H
+#define SIM_AT24_H
+
+#include "pic.h"
+
+namespace sim {
+
+class At24 : public I2cSlave {
+public:
+    explicit At24(Pic &pic, size_t size = 4096, size_t page = 32);
+
+    uint8_t address() const override { return 0x50; }
+    bool busy() const override { return pic.now < write_done; }
+    void start(bool read) override;
+    bool write(uint8_t b) override;
+    uint8_t read() override;
+    void stop() override;
+
+    std::vector<uint8_t> mem;
+    unsigned long page_writes = 0;
+    unsigned long bytes_written = 0;
+
+private:
+    Pic &pic;
+    size_t page;
+    size_t ptr = 0;
+    int addr_left = 0;              // address bytes still expected
+    size_t latched = 0;             // data bytes since the address
+    std::vector<std::pair<size_t, uint8_t>> latch;
+    cycles write_done = 0;
+};
+
+} // namespace sim
+
+#endif
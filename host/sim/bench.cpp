@@ -0,0 +1,222 @@
+/*
+ * File:   bench.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 23, 2026, 9:30 AM
+ */
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace sim {
+
+Bench::Bench(Board &b) : board(b)
+{
+    if (board.lcd)
+        board.lcd->on_write.push_back([this](cycles now, bool rs, uint8_t) { lcd_written(now, rs); });
+    pic.on_tx.push_back([this](uint8_t b, cycles now) { tx(b, now); });
+    board.outputs.on_change.push_back([this](const Outputs::Pin &p, cycles now) { output(p, now); });
+}
+
+std::string Bench::check(const std::vector<std::string> &a)
+{
+    if (a.size() < 2)
+        return "'measure' needs a name and a condition";
+    const std::string &c = a[1];
+    size_t need = c == "lcd" ? 4 : c == "field" ? 5 : c == "char" ? 2 : c == "uart" ? 3 : c == "pin" ? 4 : c == "bytes" ? 3 : 0;
+    if (!need)
+        return "unknown condition '" + c + "'";
+    if (a.size() < need)
+        return "'" + c + "' condition is missing arguments";
+    if ((c == "lcd" || c == "field" || c == "char") && !board.lcd)
+        return "board '" + board.name + "' has no LCD";
+    if (c == "field") {
+        int row = atoi(a[2].c_str()), col = atoi(a[3].c_str()), width = atoi(a[4].c_str());
+        if (row < 0 || row > 1 || col < 0 || width < 1 || col + width > 16)
+            return "field must lie within one 16-character row";
+        if (!find_field(std::vector<std::string>(a.begin() + 1, a.end())))
+            fields.push_back({ row, col, width, "" });
+    }
+    if (c == "bytes" && atoi(a[2].c_str()) < 1)
+        return "byte count must be at least 1";
+    if (c == "pin") {
+        bool found = false;
+        for (auto &p : board.outputs.pins)
+            found |= p.name == a[2];
+        if (!found)
+            return "board '" + board.name + "' has no output '" + a[2] + "'";
+        if (a[3] != "on" && a[3] != "off")
+            return "pin state must be on or off";
+    }
+    return "";
+}
+
+void Bench::start(const std::vector<std::string> &a, cycles at)
+{
+    for (size_t i = 0; i < open.size(); i++) {
+        if (open[i].name == a[0]) {
+            series[a[0]].timeouts++;
+            open.erase(open.begin() + i);
+            break;
+        }
+    }
+    if (!series.count(a[0]))
+        order.push_back(a[0]);
+    series[a[0]];
+
+    Open o;
+    o.name = a[0];
+    o.cond.assign(a.begin() + 1, a.end());
+    o.at = at;
+    if (o.cond[0] == "field")
+        o.before = find_field(o.cond)->shown;
+    open.push_back(o);
+}
+
+void Bench::finish()
+{
+    for (auto &o : open)
+        series[o.name].timeouts++;
+    open.clear();
+}
+
+// The field named by a "field <row> <col> <width>" condition
+Bench::Field *Bench::find_field(const std::vector<std::string> &c)
+{
+    int row = atoi(c[1].c_str()), col = atoi(c[2].c_str()), width = atoi(c[3].c_str());
+    for (auto &f : fields)
+        if (f.row == row && f.col == col && f.width == width)
+            return &f;
+    return nullptr;
+}
+
+std::string Bench::text(const Field &f) const
+{
+    std::string s;
+    for (int i = 0; i < f.width; i++)
+        s += (char)board.lcd->cell(f.row, f.col + i);
+    return s;
+}
+
+void Bench::close(size_t i, cycles now)
+{
+    series[open[i].name].samples.push_back(now - open[i].at);
+    open.erase(open.begin() + i);
+}
+
+void Bench::lcd_written(cycles now, bool rs)
+{
+    for (auto &f : fields) {
+        std::string s = text(f);
+        if (s.find(' ') == std::string::npos)
+            f.shown = s;
+    }
+    for (size_t i = 0; i < open.size();) {
+        const Open &o = open[i];
+        const std::vector<std::string> &c = o.cond;
+        bool done = false;
+        if (now < o.at)
+            ;
+        else if (c[0] == "char")
+            done = rs;
+        else if (c[0] == "lcd") {
+            std::string want;
+            for (size_t j = 2; j < c.size(); j++)
+                want += (j > 2 ? " " : "") + c[j];
+            done = board.lcd->line(atoi(c[1].c_str())).find(want) != std::string::npos;
+        } else if (c[0] == "field") {
+            const Field *f = find_field(c);
+            done = f->shown == text(*f) && f->shown != o.before;
+        }
+        if (done)
+            close(i, now);
+        else
+            i++;
+    }
+}
+
+void Bench::tx(uint8_t b, cycles now)
+{
+    for (size_t i = 0; i < open.size();) {
+        Open &o = open[i];
+        if ((o.cond[0] != "uart" && o.cond[0] != "bytes") || now < o.at) {
+            i++;
+            continue;
+        }
+        o.seen += (char)b;
+        if (o.cond[0] == "bytes") {
+            if (o.seen.size() >= (size_t)atoi(o.cond[1].c_str()))
+                close(i, now);
+            else
+                i++;
+            continue;
+        }
+        std::string want;
+        for (size_t j = 1; j < o.cond.size(); j++)
+            want += (j > 1 ? " " : "") + o.cond[j];
+        if (o.seen.find(want) != std::string::npos)
+            close(i, now);
+        else
+            i++;
+    }
+}
+
+void Bench::output(const Outputs::Pin &p, cycles now)
+{
+    for (size_t i = 0; i < open.size();) {
+        const Open &o = open[i];
+        if (o.cond[0] == "pin" && now >= o.at && o.cond[1] == p.name && (o.cond[2] == "on") == p.on)
+            close(i, now);
+        else
+            i++;
+    }
+}
+
+// Nearest-rank percentile of a sorted series
+cycles Bench::percentile(const std::vector<cycles> &v, double q) const
+{
+    size_t rank = (size_t)std::ceil(q * v.size());
+    return v[rank ? rank - 1 : 0];
+}
+
+void Bench::print(FILE *f) const
+{
+    for (auto &name : order) {
+        const Series &s = series.at(name);
+        std::vector<cycles> v = s.samples;
+        std::sort(v.begin(), v.end());
+        if (v.empty()) {
+            fprintf(f, "  %-22s no samples, %lu timeouts\n", name.c_str(), s.timeouts);
+            continue;
+        }
+        fprintf(f, "  %-22s n=%zu p50 %.3f ms  p99 %.3f ms  max %.3f ms%s\n", name.c_str(), v.size(),
+                to_ms(percentile(v, 0.50)), to_ms(percentile(v, 0.99)), to_ms(v.back()),
+                s.timeouts ? (", " + std::to_string(s.timeouts) + " timeouts").c_str() : "");
+    }
+}
+
+bool Bench::save(const char *path) const
+{
+    FILE *f = fopen(path, "a");
+    if (!f)
+        return false;
+    if (ftell(f) == 0)
+        fprintf(f, "board,scenario,samples,timeouts,p50_ms,p99_ms,max_ms\n");
+    for (auto &name : order) {
+        const Series &s = series.at(name);
+        std::vector<cycles> v = s.samples;
+        std::sort(v.begin(), v.end());
+        if (v.empty())
+            fprintf(f, "%s,%s,0,%lu,,,\n", board.name.c_str(), name.c_str(), s.timeouts);
+        else
+            fprintf(f, "%s,%s,%zu,%lu,%.3f,%.3f,%.3f\n", board.name.c_str(), name.c_str(), v.size(),
+                    s.timeouts, to_ms(percentile(v, 0.50)), to_ms(percentile(v, 0.99)), to_ms(v.back()));
+    }
+    return fclose(f) == 0;
+}
+
+} // namespace sim
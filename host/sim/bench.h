@@ -0,0 +1,83 @@
+/*
+ * File:   bench.h
+ * Author: Rakesh B
+ *
+ * Created on October 23, 2026, 9:30 AM
+ */
+
+// Stimulus-to-effect latency for picsim scripts. A "measure" line starts a
+// sample at the end of the stimulus just applied (the last stop bit of an
+// RFID frame, the edge of a button or key) and the sample completes at the
+// first LCD write, transmitted byte or output edge that makes its
+// condition true:
+//
+//   lcd <row> <text>            the row contains text
+//   field <row> <col> <width>   the field shows a value other than the
+//                               last one it showed (blank = blinked out)
+//   char                        any character written to the display
+//   uart <text>                 text transmitted since the stimulus
+//   bytes <n>                   n bytes transmitted since the stimulus
+//   pin <output> on|off         the output switches to that state
+//
+// A sample still open when the next one of the same name starts, or when
+// the run ends, counts as a timeout.
+
+#ifndef SIM_BENCH_H
+#define SIM_BENCH_H
+
+#include "board.h"
+
+#include <cstdio>
+#include <map>
+
+namespace sim {
+
+class Bench {
+public:
+    explicit Bench(Board &board);
+
+    // Validates the words after "measure"; returns an error or ""
+    std::string check(const std::vector<std::string> &argv);
+    void start(const std::vector<std::string> &argv, cycles at);
+    void finish();
+    bool empty() const { return order.empty(); }
+
+    void print(FILE *f) const;
+    // One CSV row per scenario, header first when the file is empty
+    bool save(const char *path) const;
+
+private:
+    struct Open {
+        std::string name;
+        std::vector<std::string> cond;
+        cycles at;
+        std::string seen;         // uart: bytes since the stimulus
+        std::string before;       // field: value shown before the stimulus
+    };
+    struct Field {
+        int row, col, width;
+        std::string shown;        // last value with no blanks in it
+    };
+    struct Series {
+        std::vector<cycles> samples;
+        unsigned long timeouts = 0;
+    };
+
+    Board &board;
+    std::vector<Open> open;
+    std::map<std::string, Series> series;
+    std::vector<std::string> order;
+    std::vector<Field> fields;
+
+    Field *find_field(const std::vector<std::string> &cond);
+    std::string text(const Field &f) const;
+    void lcd_written(cycles now, bool rs);
+    void tx(uint8_t b, cycles now);
+    void output(const Outputs::Pin &p, cycles now);
+    void close(size_t i, cycles now);
+    cycles percentile(const std::vector<cycles> &sorted, double q) const;
+};
+
+} // namespace sim
+
+#endif
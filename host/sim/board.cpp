@@ -0,0 +1,65 @@
+/*
+ * File:   board.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "board.h"
+
+namespace sim {
+
+std::unique_ptr<Board> board_create(const std::string &name)
+{
+    std::unique_ptr<Board> b(new Board);
+    b->name = name;
+
+    if (name == "battery") {
+        b->firmware = "battery_sharing.c";
+        b->lcd.reset(new Hd44780(pic, { PD, PB, 0, PB, 1, PB, 2 }));
+        for (int i = 0; i < 4; i++) {
+            b->outputs.add("relay" + std::to_string(i + 1), PC, i);
+            b->analog.set(i, 2.0);                 // ~12.0 V through the divider
+        }
+        b->buttons.add("cal", PB, 4, false);        // RB4, weak pull-up
+        b->buttons.add("bus", PB, 5, false);        // RS-485 jumper, held = fitted
+        b->outputs.add("de", PC, 5);                // RS-485 driver enable
+    } else if (name == "temp") {
+        b->firmware = "temp_sesnor.c";
+        b->lcd.reset(new Hd44780(pic, { PD, PC, 0, PC, 1, PC, 2 }));
+        for (int i = 0; i < 8; i++)
+            b->analog.set(i, 0.22 + 0.01 * i);      // LM35s at 22-29 C
+        b->outputs.add("alarm", PC, 3);
+    } else if (name == "clock") {
+        b->firmware = "Digital_Clock.c";
+        b->lcd.reset(new Hd44780(pic, { PD, PB, 0, PB, 1, PB, 2 }));
+        b->rtc.reset(new Ds1307(pic));
+        pic.i2c_bus.push_back(b->rtc.get());
+        b->buttons.add("set", PA, 0, true);
+        b->buttons.add("inc", PA, 1, true);
+        b->buttons.add("next", PA, 2, true);
+        b->buttons.add("alarm", PA, 3, true);
+        b->outputs.add("buzzer", PC, 0);
+    } else if (name == "rtc") {
+        b->firmware = "Real_TClk.c";
+        b->lcd.reset(new Hd44780(pic, { PD, PB, 0, PB, 1, PB, 2 }));
+        b->rtc.reset(new Ds1307(pic));
+        pic.i2c_bus.push_back(b->rtc.get());
+    } else if (name == "rfid") {
+        b->firmware = "RFID_PIC.c";
+        b->lcd.reset(new Hd44780(pic, { PD, PB, 0, PB, 1, PB, 2 }));
+        b->rfid.reset(new Em18(pic));
+        b->rfid->repeat = from_ms(EM18_REPEAT_MS);
+        b->ext_eeprom.reset(new At24(pic));
+        pic.i2c_bus.push_back(b->ext_eeprom.get());
+    } else if (name == "calc") {
+        b->firmware = "mini_calsi.c";
+        b->lcd.reset(new Hd44780(pic, { PC, PD, 0, PD, 1, PD, 2 }));
+        b->keypad.reset(new Keypad(pic, PB, 0, 4));
+    } else {
+        return nullptr;
+    }
+    return b;
+}
+
+} // namespace sim
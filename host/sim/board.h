@@ -0,0 +1,44 @@
+/*
+ * File:   board.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// The six project boards: which external parts hang off which pins.
+// Parts a board does not have are left null.
+
+#ifndef SIM_BOARD_H
+#define SIM_BOARD_H
+
+#include "pic.h"
+#include "hd44780.h"
+#include "ds1307.h"
+#include "at24.h"
+#include "em18.h"
+#include "keypad.h"
+#include "inputs.h"
+
+#include <memory>
+
+namespace sim {
+
+struct Board {
+    std::string name;
+    std::string firmware;
+    std::unique_ptr<Hd44780> lcd;
+    std::unique_ptr<Ds1307> rtc;
+    std::unique_ptr<At24> ext_eeprom;
+    std::unique_ptr<Em18> rfid;
+    std::unique_ptr<Keypad> keypad;
+    Buttons buttons{pic};
+    Analog analog{pic};
+    Outputs outputs{pic};
+};
+
+// Builds the named board around `pic`; nullptr if unknown
+std::unique_ptr<Board> board_create(const std::string &name);
+
+} // namespace sim
+
+#endif
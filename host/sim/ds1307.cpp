@@ -0,0 +1,157 @@
+/*
+ * File:   ds1307.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "ds1307.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace sim {
+
+const double I2C_MAX_HZ = 100e3;
+
+static uint8_t to_bcd(int v) { return (uint8_t)((v / 10) << 4 | (v % 10)); }
+static int from_bcd(uint8_t v) { return (v >> 4) * 10 + (v & 0x0F); }
+
+// BCD increment with wrap: returns true on carry
+static bool bcd_step(uint8_t &r, uint8_t mask, int lo, int hi)
+{
+    int v = from_bcd(r & mask) + 1;
+    bool carry = v > hi;
+    r = (r & ~mask) | to_bcd(carry ? lo : v);
+    return carry;
+}
+
+static int month_days(int month, int year)
+{
+    static const int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if (month == 2 && year % 4 == 0)
+        return 29;
+    return days[(month - 1) % 12];
+}
+
+Ds1307::Ds1307(Pic &p) : pic(p)
+{
+    memset(regs, 0, sizeof regs);
+    regs[0] = 0x80;                     // CH set at first power-up
+    regs[3] = 0x01;
+    regs[4] = 0x01;
+    regs[5] = 0x01;
+    memcpy(shadow, regs, sizeof shadow);
+}
+
+void Ds1307::tick()
+{
+    if (!bcd_step(regs[0], 0x7F, 0, 59))
+        return;
+    if (!bcd_step(regs[1], 0x7F, 0, 59))
+        return;
+    uint8_t &h = regs[2];
+    if (h & 0x40) {
+        // 12-hour: 11 -> 12 flips AM/PM, 12 -> 1
+        int v = from_bcd(h & 0x1F) + 1;
+        if (v == 12)
+            h ^= 0x20;
+        if (v == 13)
+            v = 1;
+        h = (h & 0x60) | to_bcd(v);
+        if (v != 12 || (h & 0x20))
+            return;
+    } else if (!bcd_step(h, 0x3F, 0, 23)) {
+        return;
+    }
+    bcd_step(regs[3], 0x07, 1, 7);
+    int month = from_bcd(regs[5] & 0x1F);
+    int year = from_bcd(regs[6]);
+    if (!bcd_step(regs[4], 0x3F, 1, month_days(month, year)))
+        return;
+    if (bcd_step(regs[5], 0x1F, 1, 12))
+        bcd_step(regs[6], 0xFF, 0, 99);
+}
+
+void Ds1307::update()
+{
+    cycles second = from_ms(1000);
+    if (regs[0] & 0x80) {
+        second_start = pic.now;
+        return;
+    }
+    while (pic.now - second_start >= second) {
+        second_start += second;
+        tick();
+    }
+}
+
+void Ds1307::set(int hh, int mm, int ss, int dd, int mo, int yy, bool running)
+{
+    update();
+    regs[0] = to_bcd(ss) | (running ? 0 : 0x80);
+    regs[1] = to_bcd(mm);
+    regs[2] = to_bcd(hh);
+    regs[4] = to_bcd(dd);
+    regs[5] = to_bcd(mo);
+    regs[6] = to_bcd(yy);
+    second_start = pic.now;
+}
+
+std::string Ds1307::time_string()
+{
+    update();
+    char buf[48];
+    snprintf(buf, sizeof buf, "%02X:%02X:%02X %02X/%02X/%02X%s", regs[2] & 0x3F, regs[1],
+             regs[0] & 0x7F, regs[4], regs[5], regs[6], (regs[0] & 0x80) ? " (halted)" : "");
+    return buf;
+}
+
+void Ds1307::start(bool read)
+{
+    double hz = FOSC / (4.0 * (pic.peek(0x93) + 1));
+    if (hz > I2C_MAX_HZ * 1.01) {
+        char buf[64];
+        snprintf(buf, sizeof buf, "SCL %.0f kHz above the 100 kHz maximum", hz / 1e3);
+        pic.violation("DS1307", buf);
+    }
+    update();
+    memcpy(shadow, regs, sizeof shadow);
+    pointer_phase = !read;
+}
+
+bool Ds1307::write(uint8_t b)
+{
+    if (pointer_phase) {
+        pointer_phase = false;
+        ptr = b & 0x3F;
+        return true;
+    }
+    update();
+    if (ptr == 0)
+        second_start = pic.now;         // countdown chain reset
+    if (ptr < 7 && ((b & 0x0F) > 9 || ((b >> 4) & 0x07) > 9)) {
+        char buf[48];
+        snprintf(buf, sizeof buf, "register %02Xh written with non-BCD 0x%02X", ptr, b);
+        pic.violation("DS1307", buf);
+    }
+    regs[ptr] = b;
+    if (ptr < 8)
+        shadow[ptr] = b;
+    ptr = (ptr + 1) & 0x3F;
+    return true;
+}
+
+uint8_t Ds1307::read()
+{
+    uint8_t v = ptr < 8 ? shadow[ptr] : regs[ptr];
+    ptr = (ptr + 1) & 0x3F;
+    return v;
+}
+
+void Ds1307::stop()
+{
+    pointer_phase = false;
+}
+
+} // namespace sim
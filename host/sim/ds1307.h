@@ -0,0 +1,52 @@
+/*
+ * File:   ds1307.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// DS1307 RTC as an I2C slave at 0x68: BCD time registers 00h-06h,
+// control 07h and 56 bytes of NVRAM 08h-3Fh behind an auto-incrementing
+// pointer that wraps at 3Fh. The clock halt bit (CH, seconds bit 7) is
+// set at first power-up, so the time only advances once firmware clears
+// it. Reads come from a copy of the time taken at each START, and a write
+// to the seconds register restarts the one-second countdown, both as in
+// the datasheet. Time is advanced lazily from simulated cycles.
+
+#ifndef SIM_DS1307_H
+#define SIM_DS1307_H
+
+#include "pic.h"
+
+namespace sim {
+
+class Ds1307 : public I2cSlave {
+public:
+    explicit Ds1307(Pic &pic);
+
+    uint8_t address() const override { return 0x68; }
+    void start(bool read) override;
+    bool write(uint8_t b) override;
+    uint8_t read() override;
+    void stop() override;
+
+    // Set the time (binary values); `running` clears CH
+    void set(int hh, int mm, int ss, int dd, int mo, int yy, bool running);
+    bool halted() { update(); return regs[0] & 0x80; }
+    std::string time_string();
+    uint8_t regs[64];
+
+private:
+    Pic &pic;
+    cycles second_start = 0;        // start of the current second
+    uint8_t shadow[8];              // time latched at START
+    uint8_t ptr = 0;
+    bool pointer_phase = false;
+
+    void update();
+    void tick();
+};
+
+} // namespace sim
+
+#endif
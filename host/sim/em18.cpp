@@ -0,0 +1,59 @@
+/*
+ * File:   em18.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "em18.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace sim {
+
+Em18::Em18(Pic &p, double b) : pic(p), baud(b)
+{
+    pic.attach(this);
+}
+
+std::string Em18::frame(const std::string &tag)
+{
+    if (tag.size() != 10)
+        return tag;
+    unsigned sum = 0;
+    for (int i = 0; i < 10; i += 2)
+        sum ^= strtoul(tag.substr(i, 2).c_str(), nullptr, 16);
+    char cs[3];
+    snprintf(cs, sizeof cs, "%02X", sum & 0xFF);
+    return tag + cs;
+}
+
+cycles Em18::present(const std::string &tag, cycles hold)
+{
+    current = frame(tag);
+    until = pic.now + hold;
+    return send(pic.now);
+}
+
+cycles Em18::send(cycles now)
+{
+    reads++;
+    for (auto &l : on_read)
+        l(current, now);
+    cycles last = now;
+    for (char c : current)
+        last = pic.rx_byte((uint8_t)c, baud);
+    if (repeat && now + repeat <= until) {
+        due = now + repeat;
+        pic.reschedule();
+    }
+    return last;
+}
+
+void Em18::service(cycles now)
+{
+    send(now);
+}
+
+} // namespace sim
@@ -0,0 +1,48 @@
+/*
+ * File:   em18.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// EM-18 125 kHz reader on the PIC's RX pin: each card read is sent as 12
+// ASCII characters at 9600 8N1 - the 10 hex digits of the tag followed by
+// the XOR checksum of its five bytes. A card held on the reader is sent
+// again every `repeat` while it stays in the field (0 = only once); the
+// rfid board uses EM18_REPEAT_MS.
+
+#ifndef SIM_EM18_H
+#define SIM_EM18_H
+
+#include "pic.h"
+
+namespace sim {
+
+constexpr double EM18_REPEAT_MS = 100;
+
+class Em18 : public Device {
+public:
+    explicit Em18(Pic &pic, double baud = 9600);
+
+    // Present a tag (10 hex digits, checksum appended; or all 12 characters);
+    // returns when the last character of the first read has arrived
+    cycles present(const std::string &tag, cycles hold = 0);
+    static std::string frame(const std::string &tag);
+
+    cycles repeat = 0;
+    unsigned long reads = 0;
+    std::vector<std::function<void(const std::string &, cycles)>> on_read;
+
+    void service(cycles now) override;
+
+private:
+    Pic &pic;
+    double baud;
+    std::string current;
+    cycles until = 0;
+    cycles send(cycles now);
+};
+
+} // namespace sim
+
+#endif
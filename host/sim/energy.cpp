@@ -0,0 +1,142 @@
+/*
+ * File:   energy.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 10:00 AM
+ */
+
+#include "energy.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace sim {
+
+const double AT24_WRITE_MS = 5;
+const int LM35_COUNT = 8;
+
+Energy::Energy(Board &b) : board(b)
+{
+    table = {
+        { "run", 7.0 },           // PIC16F877A IDD, HS 20 MHz
+        { "sleep", 0.0015 },      // IPD, WDT off
+        { "adc", 0.22 },
+        { "mssp", 1.0 },          // SDA/SCL low into 4.7k pull-ups
+        { "usart", 0.5 },
+        { "lcd", 1.5 },           // HD44780 module, backlight not wired
+        { "regulator", 5.0 },     // 7805 quiescent
+        { "ds1307", 0.2 },
+        { "em18", 50.0 },
+        { "lm35", 0.06 },
+        { "at24_write", 3.0 },
+        { "relay", 72.0 },        // 5 V coil, each
+        { "buzzer", 30.0 },
+        { "alarm", 10.0 },        // LED
+        { "de", 25.0 },           // RS-485 driver enabled, terminated line
+    };
+}
+
+std::string Energy::load(const char *path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return std::string(path) + ": cannot open";
+    std::string text;
+    for (int n = 1; std::getline(in, text); n++) {
+        std::istringstream ss(text.substr(0, text.find('#')));
+        std::string name, extra;
+        double ma;
+        if (!(ss >> name))
+            continue;
+        if (!(ss >> ma) || ma < 0 || (ss >> extra))
+            return std::string(path) + ":" + std::to_string(n) + ": expected \"<name> <mA>\"";
+        table[name] = ma;
+    }
+    return "";
+}
+
+double Energy::current(const std::string &name) const
+{
+    auto it = table.find(name);
+    if (it != table.end())
+        return it->second;
+    std::string base = name;
+    while (!base.empty() && isdigit((unsigned char)base.back()))
+        base.pop_back();
+    it = table.find(base);
+    return it != table.end() ? it->second : 0;
+}
+
+std::vector<Energy::Part> Energy::parts() const
+{
+    std::vector<Part> v;
+    if (!pic.now)
+        return v;
+    double t = (double)pic.now;
+    double asleep = (double)pic.asleep() / t;
+    v.push_back({ "run", current("run"), 1 - asleep, GROUP_CORE });
+    v.push_back({ "sleep", current("sleep"), asleep, GROUP_CORE });
+    v.push_back({ "adc", current("adc"), pic.adc_cycles / t, GROUP_PERIPHERAL });
+    v.push_back({ "mssp", current("mssp"), pic.mssp_cycles / t, GROUP_PERIPHERAL });
+    v.push_back({ "usart", current("usart"), (pic.tx_cycles + pic.rx_cycles) / t, GROUP_PERIPHERAL });
+    v.push_back({ "regulator", current("regulator"), 1, GROUP_BOARD });
+    if (board.lcd)
+        v.push_back({ "lcd", current("lcd"), 1, GROUP_BOARD });
+    if (board.rtc)
+        v.push_back({ "ds1307", current("ds1307"), 1, GROUP_BOARD });
+    if (board.rfid)
+        v.push_back({ "em18", current("em18"), 1, GROUP_BOARD });
+    if (board.name == "temp")
+        v.push_back({ "lm35", current("lm35") * LM35_COUNT, 1, GROUP_BOARD });
+    if (board.ext_eeprom)
+        v.push_back({ "at24_write", current("at24_write"),
+                      std::min(1.0, from_ms(AT24_WRITE_MS) * board.ext_eeprom->page_writes / t), GROUP_BOARD });
+    for (auto &p : board.outputs.pins)
+        v.push_back({ p.name, current(p.name), board.outputs.on_time(p) / t, GROUP_OUTPUT });
+    return v;
+}
+
+double Energy::average_ma() const
+{
+    double sum = 0;
+    for (auto &p : parts())
+        sum += p.ma * p.share;
+    return sum;
+}
+
+void Energy::print(FILE *f, double capacity_mah) const
+{
+    double avg = average_ma();
+    for (auto &p : parts())
+        fprintf(f, "  %-12s %9.4f mA x %7.3f %% = %9.4f mA  %5.1f %%\n", p.name.c_str(), p.ma,
+                100 * p.share, p.ma * p.share, avg > 0 ? 100 * p.ma * p.share / avg : 0.0);
+    if (capacity_mah > 0 && avg > 0)
+        fprintf(f, "  %.0f mAh lasts %.1f h (%.1f days)\n", capacity_mah, capacity_mah / avg,
+                capacity_mah / avg / 24);
+}
+
+bool Energy::save(const char *path, double capacity_mah) const
+{
+    FILE *f = fopen(path, "a");
+    if (!f)
+        return false;
+    if (ftell(f) == 0)
+        fprintf(f, "board,hours,awake_pct,avg_mA,core_mA,peripheral_mA,board_mA,output_mA,capacity_mAh,life_h\n");
+    double group[GROUPS] = {};
+    for (auto &p : parts())
+        group[p.group] += p.ma * p.share;
+    double avg = average_ma();
+    fprintf(f, "%s,%.3f,%.3f,%.4f,%.4f,%.4f,%.4f,%.4f,", board.name.c_str(), to_ms(pic.now) / 3.6e6,
+            pic.now ? 100.0 * (pic.now - pic.asleep()) / pic.now : 0.0, avg, group[GROUP_CORE],
+            group[GROUP_PERIPHERAL], group[GROUP_BOARD], group[GROUP_OUTPUT]);
+    if (capacity_mah > 0 && avg > 0)
+        fprintf(f, "%.0f,%.1f\n", capacity_mah, capacity_mah / avg);
+    else
+        fprintf(f, ",\n");
+    return fclose(f) == 0;
+}
+
+} // namespace sim
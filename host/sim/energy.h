@@ -0,0 +1,68 @@
+/*
+ * File:   energy.h
+ * Author: Rakesh B
+ *
+ * Created on October 27, 2026, 10:00 AM
+ */
+
+// Supply current for a picsim run. Each part of the board draws a fixed
+// current while it is active, and the run's average is the sum of
+// current x active share:
+//
+//   run          core awake (20 MHz HS)        share of time not in SLEEP
+//   sleep        core in SLEEP                 share of time in SLEEP
+//   adc          converting                    Pic::adc_cycles
+//   mssp         I2C bus busy (pull-ups)       Pic::mssp_cycles
+//   usart        a byte on TX or RX            Pic::tx_cycles + rx_cycles
+//   lcd, regulator, ds1307, em18               always, if the board has one
+//   lm35         per sensor, temp board        always
+//   at24_write   24C32 write cycle (tWR)       page writes x 5 ms
+//   <output>     while the output is on, looked up by the output's name,
+//                then with trailing digits dropped (relay1 -> relay)
+//
+// The defaults are typical datasheet figures at 5 V; a table of
+// "<name> <mA>" lines (-p) overrides any of them. Battery life assumes the
+// scenario repeats until the battery is flat.
+
+#ifndef SIM_ENERGY_H
+#define SIM_ENERGY_H
+
+#include "board.h"
+
+#include <cstdio>
+#include <map>
+
+namespace sim {
+
+class Energy {
+public:
+    explicit Energy(Board &board);
+
+    // Reads a current table; returns an error or ""
+    std::string load(const char *path);
+
+    struct Part {
+        std::string name;
+        double ma;                // while active
+        double share;             // active share of the run
+        int group;                // GROUP_*, for the CSV columns
+    };
+    enum { GROUP_CORE, GROUP_PERIPHERAL, GROUP_BOARD, GROUP_OUTPUT, GROUPS };
+    std::vector<Part> parts() const;
+    double average_ma() const;
+
+    // Breakdown, and life on capacity_mah if not zero
+    void print(FILE *f, double capacity_mah) const;
+    // One CSV row per run, header first when the file is empty
+    bool save(const char *path, double capacity_mah) const;
+
+private:
+    Board &board;
+    std::map<std::string, double> table;
+
+    double current(const std::string &name) const;
+};
+
+} // namespace sim
+
+#endif
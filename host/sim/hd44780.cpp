@@ -0,0 +1,154 @@
+/*
+ * File:   hd44780.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "hd44780.h"
+
+#include <cstdio>
+
+namespace sim {
+
+const double POWER_ON_MS = 15.0;
+const double EXEC_US = 37.0;
+const double CLEAR_US = 1520.0;
+const double PWEH_NS = 230.0;
+
+Hd44780::Hd44780(Pic &p, const LcdPins &pn) : pic(p), pins(pn)
+{
+    for (auto &c : ddram)
+        c = ' ';
+    pic.on_pins.push_back([this](int port, uint8_t changed) { pins_changed(port, changed); });
+    pic.pin_drivers.push_back([this](int port, uint8_t *mask) { return drive(port, mask); });
+}
+
+std::string Hd44780::line(int n) const
+{
+    uint8_t base = n ? 0x40 : 0x00;
+    std::string s;
+    for (int i = 0; i < 16; i++) {
+        uint8_t c = ddram[base + i];
+        if (c == 0xDF)
+            s += "\u00b0";                  // degree sign in the A00 ROM
+        else
+            s += (c >= 0x20 && c < 0x7F) ? (char)c : '?';
+    }
+    return s;
+}
+
+// Busy flag and address counter while the firmware reads (RS=0, RW=1)
+uint8_t Hd44780::drive(int port, uint8_t *mask)
+{
+    if (port != pins.data_port || !pic.pin_out(pins.rw_port, pins.rw_bit) ||
+        !pic.pin_out(pins.en_port, pins.en_bit) || pic.pin_out(pins.rs_port, pins.rs_bit))
+        return 0;
+    *mask = 0xFF;
+    return (pic.now < busy_until ? 0x80 : 0) | (ac & 0x7F);
+}
+
+void Hd44780::pins_changed(int port, uint8_t changed)
+{
+    bool en = pic.pin_out(pins.en_port, pins.en_bit);
+    if (port == pins.rs_port && (changed >> pins.rs_bit & 1) && en)
+        pic.violation("LCD", "RS changed while EN high");
+    if (port != pins.en_port || !(changed >> pins.en_bit & 1))
+        return;
+    if (en) {
+        en_rise = pic.now;
+        return;
+    }
+    if (pic.pin_out(pins.rw_port, pins.rw_bit))
+        return;                               // end of a read cycle
+    if (to_us(pic.now - en_rise) * 1000 < PWEH_NS) {
+        pic.violation("LCD", "EN pulse shorter than 230 ns");
+        dropped++;
+        return;
+    }
+    if (pic.tris[pins.data_port] != 0)
+        pic.violation("LCD", "data bus not driven (TRIS bits set) at EN falling edge");
+    latch(pic.pin_out(pins.rs_port, pins.rs_bit), pic.outputs(pins.data_port));
+}
+
+void Hd44780::advance()
+{
+    if (increment) {
+        ac++;
+        if (ac == 0x28)
+            ac = 0x40;
+        else if (ac >= 0x68)
+            ac = 0x00;
+    } else {
+        if (ac == 0x00)
+            ac = 0x67;
+        else if (ac == 0x40)
+            ac = 0x27;
+        else
+            ac--;
+    }
+}
+
+void Hd44780::latch(bool rs, uint8_t v)
+{
+    char buf[96];
+    if (pic.now < from_ms(POWER_ON_MS)) {
+        snprintf(buf, sizeof buf, "write before the %.0f ms power-on delay", POWER_ON_MS);
+        pic.violation("LCD", buf);
+        dropped++;
+        return;
+    }
+    if (pic.now < busy_until) {
+        snprintf(buf, sizeof buf, "%s 0x%02X written while busy", rs ? "data" : "command", v);
+        pic.violation("LCD", buf);
+        dropped++;
+        return;
+    }
+    double exec = EXEC_US;
+    if (rs) {
+        chars++;
+        if (!cgram)
+            ddram[ac & 0x7F] = v;
+        advance();
+    } else {
+        commands++;
+        if (v & 0x80) {
+            ac = v & 0x7F;
+            cgram = false;
+        } else if (v & 0x40) {
+            cgram = true;
+        } else if (v & 0x20) {
+            eight_bit = v & 0x10;
+            if (!eight_bit)
+                pic.violation("LCD", "4-bit interface selected; only 8-bit is modelled");
+        } else if (v & 0x10) {
+            // cursor/display shift: cursor moves only
+            if (!(v & 0x08)) {
+                bool inc = increment;
+                increment = v & 0x04;
+                advance();
+                increment = inc;
+            }
+        } else if (v & 0x08) {
+            // display on/off control, nothing to track
+        } else if (v & 0x04) {
+            increment = v & 0x02;
+        } else if (v & 0x02) {
+            ac = 0;
+            cgram = false;
+            exec = CLEAR_US;
+        } else if (v & 0x01) {
+            for (auto &c : ddram)
+                c = ' ';
+            ac = 0;
+            cgram = false;
+            increment = true;
+            exec = CLEAR_US;
+        }
+    }
+    busy_until = pic.now + from_us(exec);
+    for (auto &l : on_write)
+        l(pic.now, rs, v);
+}
+
+} // namespace sim
@@ -0,0 +1,57 @@
+/*
+ * File:   hd44780.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// HD44780 16x2 character LCD on an 8-bit bus. Commands and data are
+// latched on the falling edge of EN and then keep the controller busy
+// (1.52 ms for clear/home, 37 us otherwise); anything latched while busy,
+// before the 15 ms power-on time, or with EN high for less than 230 ns is
+// reported as a timing violation and the write is dropped, as on the real
+// part.
+
+#ifndef SIM_HD44780_H
+#define SIM_HD44780_H
+
+#include "pic.h"
+
+namespace sim {
+
+struct LcdPins {
+    int data_port;
+    int rs_port, rs_bit;
+    int rw_port, rw_bit;
+    int en_port, en_bit;
+};
+
+class Hd44780 {
+public:
+    Hd44780(Pic &pic, const LcdPins &pins);
+
+    std::string line(int n) const;       // visible 16 characters of row n
+    uint8_t cell(int row, int col) const { return ddram[(row ? 0x40 : 0) + col]; }
+    cycles busy_until = 0;
+    unsigned long commands = 0, chars = 0, dropped = 0;
+
+    // Called after every accepted write (command or character)
+    std::vector<std::function<void(cycles, bool rs, uint8_t)>> on_write;
+
+private:
+    Pic &pic;
+    LcdPins pins;
+    cycles en_rise = 0;
+    uint8_t ddram[0x80];
+    uint8_t ac = 0;
+    bool increment = true, cgram = false, eight_bit = true;
+
+    void pins_changed(int port, uint8_t changed);
+    void latch(bool rs, uint8_t v);
+    void advance();
+    uint8_t drive(int port, uint8_t *mask);
+};
+
+} // namespace sim
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * File:   inputs.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "inputs.h"
+
+namespace sim {
+
+// ---------------- Buttons ----------------
+
+Buttons::Buttons(Pic &p) : pic(p)
+{
+    pic.pin_drivers.push_back([this](int port, uint8_t *mask) { return drive(port, mask); });
+}
+
+void Buttons::add(const std::string &name, int port, int bit, bool pullup)
+{
+    buttons[name] = { port, bit, pullup, false };
+}
+
+bool Buttons::set(const std::string &name, bool pressed)
+{
+    auto it = buttons.find(name);
+    if (it == buttons.end())
+        return false;
+    it->second.pressed = pressed;
+    for (auto &l : on_change)
+        l(name, pressed, pic.now);
+    return true;
+}
+
+uint8_t Buttons::drive(int port, uint8_t *mask)
+{
+    uint8_t v = 0;
+    for (auto &b : buttons) {
+        const Button &bt = b.second;
+        if (bt.port != port || (!bt.pressed && !bt.pullup))
+            continue;
+        *mask |= 1 << bt.bit;
+        if (!bt.pressed)
+            v |= 1 << bt.bit;
+    }
+    return v;
+}
+
+// ---------------- Analog ----------------
+
+Analog::Analog(Pic &p) : pic(p)
+{
+    pic.analog_source = [this](int ch, cycles t) { return at(ch, t); };
+}
+
+double Analog::at(int ch, cycles t) const
+{
+    const Segment &s = seg[ch & 7];
+    if (t >= s.t1)
+        return s.v1;
+    if (t <= s.t0)
+        return s.v0;
+    return s.v0 + (s.v1 - s.v0) * (double)(t - s.t0) / (double)(s.t1 - s.t0);
+}
+
+void Analog::set(int ch, double volts)
+{
+    seg[ch & 7] = { pic.now, pic.now, volts, volts };
+}
+
+void Analog::ramp(int ch, double volts, cycles duration)
+{
+    double v0 = at(ch, pic.now);
+    seg[ch & 7] = { pic.now, pic.now + duration, v0, volts };
+}
+
+// ---------------- Outputs ----------------
+
+Outputs::Outputs(Pic &p) : pic(p)
+{
+    pic.on_pins.push_back([this](int port, uint8_t changed) { pins_changed(port, changed); });
+}
+
+void Outputs::add(const std::string &name, int port, int bit)
+{
+    pins.push_back({ name, port, bit, pic.pin_out(port, bit), pic.now, 0, 0 });
+}
+
+void Outputs::pins_changed(int port, uint8_t changed)
+{
+    for (auto &p : pins) {
+        if (p.port != port || !(changed >> p.bit & 1))
+            continue;
+        bool on = pic.pin_out(port, p.bit);
+        if (on == p.on)
+            continue;
+        if (p.on)
+            p.on_time += pic.now - p.since;
+        p.on = on;
+        p.since = pic.now;
+        p.edges++;
+        for (auto &l : on_change)
+            l(p, pic.now);
+    }
+}
+
+} // namespace sim
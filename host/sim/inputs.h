@@ -0,0 +1,76 @@
+/*
+ * File:   inputs.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// Simple board I/O around the PIC: push buttons, scriptable analog
+// sources on AN0-AN7 and named digital outputs (relays, buzzer) whose
+// on-time and edges are recorded.
+
+#ifndef SIM_INPUTS_H
+#define SIM_INPUTS_H
+
+#include "pic.h"
+
+#include <map>
+
+namespace sim {
+
+// Buttons to ground. With `pullup` an external resistor holds the pin
+// high while released; otherwise the pin floats and relies on PORTB's
+// weak pull-ups.
+class Buttons {
+public:
+    explicit Buttons(Pic &pic);
+    void add(const std::string &name, int port, int bit, bool pullup);
+    bool set(const std::string &name, bool pressed);
+    std::vector<std::function<void(const std::string &, bool, cycles)>> on_change;
+
+private:
+    struct Button { int port, bit; bool pullup, pressed; };
+    Pic &pic;
+    std::map<std::string, Button> buttons;
+    uint8_t drive(int port, uint8_t *mask);
+};
+
+// Piecewise-linear voltage per channel: set() jumps, ramp() slews
+// linearly from the present value over `duration`
+class Analog {
+public:
+    explicit Analog(Pic &pic);
+    void set(int ch, double volts);
+    void ramp(int ch, double volts, cycles duration);
+    double at(int ch, cycles t) const;
+
+private:
+    struct Segment { cycles t0, t1; double v0, v1; };
+    Pic &pic;
+    Segment seg[8] = {};
+};
+
+// Named output pins, e.g. relays
+class Outputs {
+public:
+    explicit Outputs(Pic &pic);
+    void add(const std::string &name, int port, int bit);
+    struct Pin {
+        std::string name;
+        int port, bit;
+        bool on;
+        cycles since, on_time;
+        unsigned long edges;
+    };
+    std::vector<Pin> pins;
+    cycles on_time(const Pin &p) const { return p.on_time + (p.on ? pic.now - p.since : 0); }
+    std::vector<std::function<void(const Pin &, cycles)>> on_change;
+
+private:
+    Pic &pic;
+    void pins_changed(int port, uint8_t changed);
+};
+
+} // namespace sim
+
+#endif
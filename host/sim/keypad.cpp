@@ -0,0 +1,43 @@
+/*
+ * File:   keypad.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "keypad.h"
+
+#include <cstring>
+
+namespace sim {
+
+static const char layout[] = "789/456*123-C0=+";
+
+Keypad::Keypad(Pic &p, int pt, int c0, int r0) : pic(p), port(pt), col0(c0), row0(r0)
+{
+    pic.pin_drivers.push_back([this](int pt, uint8_t *mask) { return drive(pt, mask); });
+}
+
+bool Keypad::press(char key)
+{
+    const char *k = strchr(layout, key);
+    if (!key || !k)
+        return false;
+    held = k - layout;
+    for (auto &l : on_press)
+        l(key, pic.now);
+    return true;
+}
+
+uint8_t Keypad::drive(int pt, uint8_t *mask)
+{
+    if (pt != port)
+        return 0;
+    *mask = 0x0F << row0;
+    if (held < 0)
+        return 0;
+    int row = held / 4, col = held % 4;
+    return pic.pin_out(port, col0 + col) ? 1 << (row0 + row) : 0;
+}
+
+} // namespace sim
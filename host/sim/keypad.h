@@ -0,0 +1,43 @@
+/*
+ * File:   keypad.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// 4x4 matrix keypad: the firmware drives the four column pins and reads
+// the four row pins, which follow the column of the held key (rows are
+// pulled low otherwise). Layout as on the calculator board:
+//
+//           col1 col2 col3 col4
+//   row1     7    8    9    /
+//   row2     4    5    6    *
+//   row3     1    2    3    -
+//   row4     C    0    =    +
+
+#ifndef SIM_KEYPAD_H
+#define SIM_KEYPAD_H
+
+#include "pic.h"
+
+namespace sim {
+
+class Keypad {
+public:
+    // Columns on bits col0..col0+3 and rows on row0..row0+3 of `port`
+    Keypad(Pic &pic, int port, int col0, int row0);
+
+    bool press(char key);            // false if the key is not on the pad
+    void release() { held = -1; }
+    std::vector<std::function<void(char, cycles)>> on_press;
+
+private:
+    Pic &pic;
+    int port, col0, row0;
+    int held = -1;                   // row * 4 + col
+    uint8_t drive(int port, uint8_t *mask);
+};
+
+} // namespace sim
+
+#endif
@@ -0,0 +1,831 @@
+/*
+ * File:   pic.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+#include "pic.h"
+
+#include <cmath>
+#include <random>
+#include <cstdio>
+
+// Interrupt service routine of the firmware under test, if it has one
+extern void isr(void) __attribute__((weak));
+
+namespace sim {
+
+Pic pic;
+
+// Register addresses (bank-qualified, as used by sim/xc.h)
+enum {
+    R_PORTA = 0x05, R_PORTE = 0x09, R_INTCON = 0x0B, R_PIR1 = 0x0C,
+    R_PIR2 = 0x0D, R_TMR1L = 0x0E, R_TMR1H = 0x0F, R_T1CON = 0x10,
+    R_TMR2 = 0x11, R_T2CON = 0x12, R_SSPBUF = 0x13, R_SSPCON = 0x14,
+    R_RCSTA = 0x18, R_TXREG = 0x19, R_RCREG = 0x1A, R_ADRESH = 0x1E,
+    R_ADCON0 = 0x1F, R_OPTION = 0x81, R_TRISA = 0x85, R_TRISE = 0x89,
+    R_PIE1 = 0x8C, R_PIE2 = 0x8D, R_SSPCON2 = 0x91, R_PR2 = 0x92,
+    R_SSPADD = 0x93, R_SSPSTAT = 0x94, R_TXSTA = 0x98, R_SPBRG = 0x99,
+    R_ADRESL = 0x9E, R_ADCON1 = 0x9F, R_EEDATA = 0x10C, R_EEADR = 0x10D,
+    R_EECON1 = 0x18C, R_EECON2 = 0x18D
+};
+
+// PIR1/PIE1 bits
+enum { F_TMR1 = 0x01, F_TMR2 = 0x02, F_SSP = 0x08, F_TX = 0x10, F_RC = 0x20, F_AD = 0x40 };
+// PIR2/PIE2 bits
+enum { F_EE = 0x10 };
+
+const unsigned SPIN_LIMIT = 8;           // identical reads before fast-forward
+const cycles OST_CYCLES = 256;           // oscillator start-up after wake (1024 Tosc)
+const double TAD_MIN_US = 1.6;
+const double ACQ_MIN_US = 19.72;
+const double FRC_TAD_US = 4.0;
+const double EE_WRITE_MS = 4.0;
+
+// Analog pins per PCFG3:0, bit n = ANn
+static const uint8_t pcfg_analog[16] = {
+    0xFF, 0xF7, 0x1F, 0x17, 0x0B, 0x03, 0x00, 0x00,
+    0xF3, 0x3F, 0x37, 0x33, 0x13, 0x03, 0x01, 0x01
+};
+
+Pic::Pic()
+{
+    reg[R_OPTION] = 0xFF;
+    reg[R_PR2] = 0xFF;
+    reg[R_TXSTA] = 0x02;
+    for (int i = 0; i < 256; i++)
+        eeprom[i] = 0xFF;
+    t1dev.p = this;
+    t2dev.p = this;
+    adcdev.p = this;
+    usartdev.p = this;
+    msspdev.p = this;
+    eedev.p = this;
+    devices = { &t1dev, &t2dev, &adcdev, &usartdev, &msspdev, &eedev };
+}
+
+void Pic::violation(const std::string &source, const std::string &msg)
+{
+    for (auto &v : violations) {
+        if (v.source == source && v.message == msg) {
+            v.count++;
+            return;
+        }
+    }
+    violations.push_back({ now, source, msg, 1 });
+    if (trace)
+        fprintf(stderr, "%10.3f ms  %s: %s\n", to_ms(now), source.c_str(), msg.c_str());
+}
+
+// ---------------- time ----------------
+
+void Pic::attach(Device *d)
+{
+    devices.push_back(d);
+    next_dirty = true;
+}
+
+cycles Pic::next_due()
+{
+    if (next_dirty) {
+        next_event = NEVER;
+        for (Device *d : devices)
+            if (d->due < next_event)
+                next_event = d->due;
+        next_dirty = false;
+    }
+    return next_event;
+}
+
+void Pic::step_to(cycles t)
+{
+    for (;;) {
+        cycles due = next_due();
+        if (due > t)
+            break;
+        if (due > now)
+            now = due;
+        for (Device *d : devices) {
+            if (d->due <= now) {
+                d->due = NEVER;
+                d->service(now);
+            }
+        }
+        next_dirty = true;
+        check_irq();
+    }
+    if (now < t)
+        now = t;
+}
+
+void Pic::run_until(cycles t)
+{
+    if (t > end)
+        t = end;
+    step_to(t);
+    if (now >= end)
+        throw Stop();
+}
+
+void Pic::access()
+{
+    sfr_accesses++;
+    run_until(now + SFR_ACCESS_CYCLES);
+    check_irq();
+}
+
+void Pic::delay(cycles n)
+{
+    spin_count = 0;
+    run_until(now + n);
+}
+
+void Pic::idle()
+{
+    spin_count = 0;
+    cycles due = next_due();
+    run_until(due == NEVER ? end : (due > now ? due : now + 1));
+}
+
+// ---------------- interrupts ----------------
+
+bool Pic::irq_pending(bool for_wake)
+{
+    uint8_t intcon = reg[R_INTCON];
+    if ((intcon >> 5 & intcon >> 2 & 1) && !for_wake)    // T0 stops in SLEEP
+        return true;
+    if (intcon >> 4 & intcon >> 1 & 1)
+        return true;
+    if (intcon >> 3 & intcon & 1)
+        return true;
+    if (!(intcon & 0x40))
+        return false;
+    uint8_t pir1 = peek(R_PIR1);
+    return (pir1 & reg[R_PIE1]) || (reg[R_PIR2] & reg[R_PIE2]);
+}
+
+void Pic::check_irq()
+{
+    if (in_isr || sleeping || !(reg[R_INTCON] & 0x80) || !irq_pending(false))
+        return;
+    in_isr = true;
+    isr_count++;
+    reg[R_INTCON] &= ~0x80;
+    spin_count = 0;
+    step_to(now + ISR_ENTRY_CYCLES);
+    if (isr)
+        isr();
+    else
+        violation("core", "interrupt taken with no handler");
+    step_to(now + ISR_EXIT_CYCLES);
+    reg[R_INTCON] |= 0x80;
+    in_isr = false;
+    spin_count = 0;
+    if (now >= end)
+        throw Stop();
+}
+
+void Pic::sleep()
+{
+    access();
+    if (irq_pending(true))
+        return;                          // wake condition already set: SLEEP is a NOP
+    cycles start = now;
+
+    // Fosc stops: synchronous timers freeze, USART/MSSP stall
+    bool t1_frozen = t1_running() && !t1_async();
+    uint16_t t1_hold = t1_value();       // before `sleeping` freezes the readout
+    uint8_t t2_hold = t2_value();
+    sleeping = true;
+    sleep_from = now;
+    if (tsr_busy)
+        violation("USART", "SLEEP while transmitting: the byte in TSR is stretched");
+    if (t1_frozen)
+        t1dev.due = NEVER;
+    t2dev.due = NEVER;
+    uint8_t tad = (reg[R_ADCON0] >> 6) | (reg[R_ADCON1] >> 4 & 0x04);
+    if ((reg[R_ADCON0] & 0x04) && (tad & 3) != 3) {
+        reg[R_ADCON0] &= ~0x04;          // conversion aborted without FRC
+        adcdev.due = NEVER;
+        violation("ADC", "conversion aborted by SLEEP (clock is not FRC)");
+    }
+    next_dirty = true;
+
+    while (!irq_pending(true)) {
+        cycles due = next_due();
+        if (due == NEVER || due >= end) {
+            now = end;
+            sleep_cycles += now - start;
+            sleep_to = now;
+            throw Stop();
+        }
+        run_until(due);
+    }
+    sleeping = false;
+    sleep_to = now;
+    sleep_cycles += now - start;
+    run_until(now + OST_CYCLES);
+
+    if (t1_frozen) {
+        t1_start = t1_hold;
+        t1_base = now;
+        t1_rebase();
+    }
+    t2_base = now - (cycles)t2_hold * ((reg[R_T2CON] & 3) == 0 ? 1 : (reg[R_T2CON] & 3) == 1 ? 4 : 16);
+    t2_config();
+    check_irq();
+}
+
+// ---------------- ports ----------------
+
+uint8_t Pic::inputs(int port)
+{
+    uint8_t v = 0;
+    if (port == PB && !(reg[R_OPTION] & 0x80))
+        v = 0xFF;                         // weak pull-ups
+    for (auto &d : pin_drivers) {
+        uint8_t mask = 0;
+        uint8_t lv = d(port, &mask);
+        v = (v & ~mask) | (lv & mask);
+    }
+    return v;
+}
+
+void Pic::pins_changed(int port, uint8_t before)
+{
+    uint8_t changed = before ^ outputs(port);
+    if (!changed)
+        return;
+    for (auto &l : on_pins)
+        l(port, changed);
+}
+
+// ---------------- register access ----------------
+
+uint8_t Pic::peek(uint16_t addr)
+{
+    switch (addr) {
+    case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: {
+        int port = addr - 0x05;
+        uint8_t v = (latch[port] & ~tris[port]) | (inputs(port) & tris[port]);
+        uint8_t an = pcfg_analog[reg[R_ADCON1] & 0x0F];
+        if (port == PA)
+            v &= ~((an & 0x0F) | (an << 1 & 0x20));
+        if (port == PE) {
+            v &= ~(an >> 5);
+            v &= 0x07;
+        }
+        if (port == PA)
+            v &= 0x3F;
+        return v;
+    }
+    case 0x85: case 0x86: case 0x87: case 0x88: case 0x89:
+        return tris[addr - 0x85];
+    case R_TMR1L:
+        return t1_value() & 0xFF;
+    case R_TMR1H:
+        return t1_value() >> 8;
+    case R_TMR2:
+        return t2_value();
+    case R_PIR1:
+        return (reg[R_PIR1] & ~(F_TX | F_RC)) | (txreg_full ? 0 : F_TX) | (rx_count ? F_RC : 0);
+    case R_TXSTA:
+        return (reg[R_TXSTA] & ~0x02) | (tsr_busy ? 0 : 0x02);
+    case R_RCREG:
+        return rx_count ? rx_fifo[0] : 0;
+    case R_ADRESH:
+        return (reg[R_ADCON1] & 0x80) ? adc_result >> 8 : adc_result >> 2;
+    case R_ADRESL:
+        return (reg[R_ADCON1] & 0x80) ? adc_result & 0xFF : (adc_result & 3) << 6;
+    default:
+        return reg[addr];
+    }
+}
+
+uint8_t Pic::read(uint16_t addr)
+{
+    access();
+    uint8_t v = peek(addr);
+    switch (addr) {
+    case R_RCREG:
+        if (rx_count) {
+            rx_fifo[0] = rx_fifo[1];
+            rx_count--;
+        }
+        break;
+    case R_SSPBUF:
+        reg[R_SSPSTAT] &= ~0x01;          // BF
+        break;
+    case R_EECON2:
+        v = 0;
+        break;
+    }
+
+    // Polling loop: the value cannot change until some device acts
+    if (addr == spin_addr && v == spin_value) {
+        if (++spin_count >= SPIN_LIMIT) {
+            spin_count = 0;
+            cycles due = next_due();
+            run_until(due == NEVER ? end : due);
+        }
+    } else {
+        spin_addr = addr;
+        spin_value = v;
+        spin_count = 0;
+    }
+    return v;
+}
+
+void Pic::modify(uint16_t addr, uint8_t mask, uint8_t bits)
+{
+    // bcf/bsf: read-modify-write in one instruction; ports read the pins
+    uint8_t v = peek(addr);
+    if (addr == R_RCREG || addr == R_SSPBUF)
+        v = reg[addr];
+    write(addr, (v & ~mask) | (bits & mask));
+}
+
+void Pic::write(uint16_t addr, uint8_t v)
+{
+    access();
+    spin_count = 0;
+    switch (addr) {
+    case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: {
+        int port = addr - 0x05;
+        uint8_t before = outputs(port);
+        latch[port] = v;
+        pins_changed(port, before);
+        return;
+    }
+    case 0x85: case 0x86: case 0x87: case 0x88: case 0x89: {
+        int port = addr - 0x85;
+        uint8_t before = outputs(port);
+        tris[port] = port == PE ? (v & 0x07) | (reg[R_TRISE] & 0xF0) : v;
+        if (port == PE)
+            reg[R_TRISE] = v & 0xF0;
+        pins_changed(port, before);
+        return;
+    }
+    case R_TMR1L:
+        t1_start = (t1_value() & 0xFF00) | v;
+        t1_base = now;
+        t1_rebase();
+        return;
+    case R_TMR1H:
+        t1_start = (t1_value() & 0x00FF) | v << 8;
+        t1_base = now;
+        t1_rebase();
+        return;
+    case R_T1CON: {
+        uint16_t cur = t1_value();
+        reg[R_T1CON] = v & 0x3F;
+        t1_start = cur;
+        t1_base = now;
+        t1_rebase();
+        return;
+    }
+    case R_TMR2:
+        if (v)
+            violation("Timer2", "TMR2 written with a non-zero value");
+        t2_base = now;
+        t2_config();
+        return;
+    case R_T2CON:
+    case R_PR2:
+        reg[addr] = v;
+        t2_base = now;
+        t2_config();
+        return;
+    case R_PIR1:
+        reg[R_PIR1] = v & ~(F_TX | F_RC);
+        return;
+    case R_INTCON:
+        reg[R_INTCON] = v;
+        check_irq();
+        return;
+    case R_PIE1:
+    case R_PIE2:
+        reg[addr] = v;
+        check_irq();
+        return;
+    case R_ADCON0: {
+        uint8_t old = reg[R_ADCON0];
+        reg[R_ADCON0] = v;
+        if (((old ^ v) & 0x38) || ((v & 1) && !(old & 1)))
+            adc_acq_start = now;
+        if ((v & 0x04) && !(old & 0x04))
+            adc_start();
+        else if (!(v & 0x04) && (old & 0x04)) {
+            adcdev.due = NEVER;           // conversion aborted by software
+            next_dirty = true;
+        }
+        return;
+    }
+    case R_ADCON1:
+        reg[R_ADCON1] = v;
+        return;
+    case R_TXREG:
+        if (!(reg[R_RCSTA] & 0x80) || !(reg[R_TXSTA] & 0x20))
+            violation("USART", "TXREG written with SPEN/TXEN clear");
+        if (txreg_full)
+            violation("USART", "TXREG written while full (byte lost)");
+        txreg = v;
+        txreg_full = true;
+        usart_schedule();
+        return;
+    case R_RCSTA:
+        if (!(v & 0x10))
+            v &= ~0x02;                   // clearing CREN clears OERR
+        reg[R_RCSTA] = (v & ~0x06) | (reg[R_RCSTA] & (v & 0x10 ? 0x06 : 0x04));
+        return;
+    case R_TXSTA:
+        reg[R_TXSTA] = v & ~0x02;
+        return;
+    case R_SSPBUF:
+        if (i2c_op != I2C_IDLE || (reg[R_SSPCON2] & 0x1F)) {
+            reg[R_SSPCON] |= 0x80;        // WCOL
+            violation("MSSP", "SSPBUF written while the bus is busy (WCOL)");
+            return;
+        }
+        reg[R_SSPBUF] = v;
+        reg[R_SSPSTAT] |= 0x05;           // BF, R_nW (transmit in progress)
+        i2c_begin(I2C_TX, 9);
+        return;
+    case R_SSPCON2: {
+        uint8_t start = v & ~reg[R_SSPCON2] & 0x1F;
+        reg[R_SSPCON2] = (reg[R_SSPCON2] & 0x40) | (v & ~0x40);
+        if (!start)
+            return;
+        if (i2c_op != I2C_IDLE) {
+            violation("MSSP", "SSPCON2 operation requested while the bus is busy");
+            return;
+        }
+        if (start & 0x01)
+            i2c_begin(I2C_START, 1);
+        else if (start & 0x02)
+            i2c_begin(I2C_RSTART, 1);
+        else if (start & 0x04)
+            i2c_begin(I2C_STOP, 1);
+        else if (start & 0x08)
+            i2c_begin(I2C_RX, 8);
+        else
+            i2c_begin(I2C_ACK, 1);
+        return;
+    }
+    case R_EECON2:
+        ee_unlock = (v == 0x55) ? 1 : (v == 0xAA && ee_unlock == 1) ? 2 : 0;
+        return;
+    case R_EECON1:
+        if (v & 0x01) {
+            reg[R_EEDATA] = eeprom[reg[R_EEADR]];
+            v &= ~0x01;
+        }
+        if ((v & 0x02) && !(reg[R_EECON1] & 0x02)) {
+            if (!(v & 0x04) || ee_unlock != 2) {
+                violation("EEPROM", "WR set without WREN and the 55h/AAh sequence");
+                v &= ~0x02;
+            } else {
+                eedev.addr = reg[R_EEADR];
+                eedev.data = reg[R_EEDATA];
+                eedev.due = now + from_ms(EE_WRITE_MS);
+                next_dirty = true;
+            }
+        } else if (reg[R_EECON1] & 0x02)
+            v |= 0x02;                    // WR cannot be cleared by software
+        ee_unlock = 0;
+        reg[R_EECON1] = v;
+        return;
+    default:
+        reg[addr] = v;
+        return;
+    }
+}
+
+// ---------------- Timer1 ----------------
+
+bool Pic::t1_running() const { return reg[R_T1CON] & 0x01; }
+bool Pic::t1_async() const { return (reg[R_T1CON] & 0x06) == 0x06; }
+
+double Pic::t1_period() const
+{
+    double pre = 1 << (reg[R_T1CON] >> 4 & 3);
+    if (reg[R_T1CON] & 0x02)
+        return pre / 32768.0 / TCY;      // T1OSC crystal
+    return pre;
+}
+
+uint16_t Pic::t1_value()
+{
+    if (!t1_running() || (sleeping && !t1_async()))
+        return t1_start;
+    return (uint16_t)(t1_start + (uint64_t)((now - t1_base) / t1_period()));
+}
+
+void Pic::t1_rebase()
+{
+    if (!t1_running()) {
+        t1dev.due = NEVER;
+    } else {
+        double left = 65536 - t1_start;
+        t1dev.due = t1_base + (cycles)std::ceil(left * t1_period());
+    }
+    next_dirty = true;
+}
+
+void Pic::Timer1Dev::service(cycles now)
+{
+    p->reg[R_PIR1] |= F_TMR1;
+    p->t1_start = 0;
+    p->t1_base = now;
+    p->t1_rebase();
+}
+
+// ---------------- Timer2 ----------------
+
+cycles Pic::t2_period() const
+{
+    uint8_t t2con = reg[R_T2CON];
+    cycles pre = (t2con & 3) == 0 ? 1 : (t2con & 3) == 1 ? 4 : 16;
+    return pre * (reg[R_PR2] + 1);
+}
+
+uint8_t Pic::t2_value()
+{
+    if (!(reg[R_T2CON] & 0x04))
+        return reg[R_TMR2];
+    uint8_t t2con = reg[R_T2CON];
+    cycles pre = (t2con & 3) == 0 ? 1 : (t2con & 3) == 1 ? 4 : 16;
+    return (uint8_t)(((now - t2_base) / pre) % (reg[R_PR2] + 1));
+}
+
+void Pic::t2_config()
+{
+    if (reg[R_T2CON] & 0x04) {
+        cycles post = (reg[R_T2CON] >> 3 & 0x0F) + 1;
+        t2dev.due = t2_base + t2_period() * post;
+    } else {
+        t2dev.due = NEVER;
+    }
+    next_dirty = true;
+}
+
+void Pic::Timer2Dev::service(cycles now)
+{
+    (void)now;
+    p->reg[R_PIR1] |= F_TMR2;
+    cycles post = (p->reg[R_T2CON] >> 3 & 0x0F) + 1;
+    p->t2_base += p->t2_period() * post;
+    p->t2_config();
+}
+
+// ---------------- ADC ----------------
+
+bool Pic::adc_pin_analog(int ch) const
+{
+    return pcfg_analog[reg[R_ADCON1] & 0x0F] >> ch & 1;
+}
+
+void Pic::adc_start()
+{
+    uint8_t adcon0 = reg[R_ADCON0];
+    if (!(adcon0 & 0x01)) {
+        violation("ADC", "GO set with ADON clear");
+        reg[R_ADCON0] &= ~0x04;
+        return;
+    }
+    int ch = adcon0 >> 3 & 7;
+    if (!adc_pin_analog(ch)) {
+        char buf[64];
+        snprintf(buf, sizeof buf, "AN%d converted while configured as digital", ch);
+        violation("ADC", buf);
+    }
+    double acq = to_us(now - adc_acq_start);
+    if (acq < ACQ_MIN_US) {
+        char buf[64];
+        snprintf(buf, sizeof buf, "acquisition time %.1f us < %.1f us", acq, ACQ_MIN_US);
+        violation("ADC", buf);
+    }
+
+    static const int div[8] = { 2, 8, 32, 0, 4, 16, 64, 0 };
+    int sel = (adcon0 >> 6) | (reg[R_ADCON1] >> 4 & 0x04);
+    double tad = div[sel] ? div[sel] / FOSC * 1e6 : FRC_TAD_US;
+    if (tad < TAD_MIN_US - 1e-9) {
+        char buf[64];
+        snprintf(buf, sizeof buf, "TAD %.2f us < %.1f us (Fosc/%d)", tad, TAD_MIN_US, div[sel]);
+        violation("ADC", buf);
+    }
+    adcdev.due = now + from_us(12 * tad);
+    adc_conv_start = now;
+    adc_conv_asleep = asleep();
+    next_dirty = true;
+}
+
+static std::mt19937 adc_rng(1);
+
+void Pic::AdcDev::service(cycles now)
+{
+    int ch = p->reg[R_ADCON0] >> 3 & 7;
+    double v = p->analog_source ? p->analog_source(ch, now) : p->analog[ch];
+    double lsb = v / 5.0 * 1024;
+    if (p->adc_noise_lsb > 0 && now > p->adc_conv_start) {
+        double awake = 1 - (double)(p->asleep() - p->adc_conv_asleep) / (now - p->adc_conv_start);
+        if (awake > 0)
+            lsb += std::normal_distribution<double>(0, p->adc_noise_lsb * awake)(adc_rng);
+    }
+    long code = std::lround(lsb);
+    p->adc_cycles += now - p->adc_conv_start;
+    p->adc_result = code < 0 ? 0 : code > 1023 ? 1023 : code;
+    p->reg[R_ADCON0] &= ~0x04;
+    p->reg[R_PIR1] |= F_AD;
+}
+
+// ---------------- USART ----------------
+
+double Pic::baud() const
+{
+    double div = (reg[R_TXSTA] & 0x04) ? 16 : 64;
+    return FOSC / (div * (reg[R_SPBRG] + 1));
+}
+
+cycles Pic::byte_cycles() const
+{
+    return (cycles)(10 / baud() / TCY + 0.5);
+}
+
+void Pic::usart_schedule()
+{
+    if (!tsr_busy && txreg_full) {
+        tsr = txreg;
+        txreg_full = false;
+        tsr_busy = true;
+        usartdev.tx_done = now + byte_cycles();
+        tx_cycles += byte_cycles();
+    }
+    cycles due = usartdev.tx_done;
+    if (!rx_pending.empty() && rx_pending.front().at < due)
+        due = rx_pending.front().at;
+    usartdev.due = due;
+    next_dirty = true;
+}
+
+cycles Pic::rx_byte(uint8_t b, double sender_baud)
+{
+    cycles at = now;
+    if (!rx_pending.empty() && rx_pending.back().at > at)
+        at = rx_pending.back().at;
+    at += (cycles)(10 / sender_baud / TCY + 0.5);
+    rx_cycles += (cycles)(10 / sender_baud / TCY + 0.5);
+    bool ferr = std::fabs(sender_baud - baud()) / baud() > 0.05;
+    rx_pending.push_back({ at, b, ferr });
+    usart_schedule();
+    return at;
+}
+
+void Pic::UsartDev::service(cycles now)
+{
+    if (tx_done <= now) {
+        tx_done = NEVER;
+        p->tsr_busy = false;
+        for (auto &l : p->on_tx)
+            l(p->tsr, now);
+    }
+    while (!p->rx_pending.empty() && p->rx_pending.front().at <= now) {
+        RxPending r = p->rx_pending.front();
+        p->rx_pending.erase(p->rx_pending.begin());
+        uint8_t &rcsta = p->reg[R_RCSTA];
+        if ((rcsta & 0x90) != 0x90 || (rcsta & 0x02))
+            continue;                     // receiver off or stalled by OERR
+        if (p->rx_count == 2) {
+            rcsta |= 0x02;
+            p->violation("USART", "receive overrun (OERR)");
+            continue;
+        }
+        cycles to = p->sleeping ? now : p->sleep_to;
+        if (to > r.at - p->byte_cycles() && p->sleep_from < r.at) {
+            rcsta |= 0x04;
+            p->violation("USART", "byte received across SLEEP: the baud clock stopped");
+            r.b ^= 0x5A;
+        } else if (r.ferr) {
+            rcsta |= 0x04;
+            p->violation("USART", "framing error: sender baud does not match SPBRG");
+            r.b ^= 0x5A;
+        } else {
+            rcsta &= ~0x04;
+        }
+        p->rx_fifo[p->rx_count++] = r.b;
+    }
+    p->usart_schedule();
+}
+
+// ---------------- MSSP I2C master ----------------
+
+cycles Pic::i2c_bit() const
+{
+    return reg[R_SSPADD] + 1;
+}
+
+void Pic::i2c_begin(I2cOp op, cycles bits)
+{
+    if ((reg[R_SSPCON] & 0x2F) != 0x28)
+        violation("MSSP", "bus operation with MSSP not in I2C master mode");
+    i2c_op = op;
+    msspdev.due = now + bits * i2c_bit();
+    mssp_cycles += bits * i2c_bit();
+    next_dirty = true;
+}
+
+void Pic::MsspDev::service(cycles now)
+{
+    (void)now;
+    uint8_t &con2 = p->reg[R_SSPCON2];
+    uint8_t &stat = p->reg[R_SSPSTAT];
+    switch (p->i2c_op) {
+    case I2C_START:
+    case I2C_RSTART:
+        con2 &= ~0x03;
+        stat = (stat & ~0x10) | 0x08;
+        p->i2c_addr_phase = true;
+        p->i2c_target = nullptr;
+        break;
+    case I2C_STOP:
+        con2 &= ~0x04;
+        stat = (stat & ~0x08) | 0x10;
+        if (p->i2c_target)
+            p->i2c_target->stop();
+        p->i2c_target = nullptr;
+        break;
+    case I2C_TX: {
+        uint8_t b = p->reg[R_SSPBUF];
+        bool ack = false;
+        if (p->i2c_addr_phase) {
+            p->i2c_addr_phase = false;
+            for (I2cSlave *s : p->i2c_bus) {
+                if (s->address() == (b >> 1) && !s->busy()) {
+                    p->i2c_target = s;
+                    s->start(b & 1);
+                    ack = true;
+                    break;
+                }
+            }
+        } else if (p->i2c_target) {
+            ack = p->i2c_target->write(b);
+        }
+        con2 = ack ? con2 & ~0x40 : con2 | 0x40;
+        stat &= ~0x05;
+        break;
+    }
+    case I2C_RX:
+        p->reg[R_SSPBUF] = p->i2c_target ? p->i2c_target->read() : 0xFF;
+        stat |= 0x01;
+        con2 &= ~0x08;
+        break;
+    case I2C_ACK:
+        if (p->i2c_target)
+            p->i2c_target->master_ack(!(con2 & 0x20));
+        con2 &= ~0x10;
+        break;
+    case I2C_IDLE:
+        return;
+    }
+    p->i2c_op = I2C_IDLE;
+    p->reg[R_PIR1] |= F_SSP;
+}
+
+// ---------------- data EEPROM ----------------
+
+void Pic::ee_wait()
+{
+    while (reg[R_EECON1] & 0x02) {
+        spin_count = 0;
+        run_until(eedev.due);
+    }
+}
+
+uint8_t Pic::eeprom_read(uint8_t a)
+{
+    ee_wait();
+    access();
+    return eeprom[a];
+}
+
+void Pic::eeprom_write(uint8_t a, uint8_t v)
+{
+    ee_wait();
+    access();
+    reg[R_EECON1] |= 0x02;
+    eedev.addr = a;
+    eedev.data = v;
+    eedev.due = now + from_ms(EE_WRITE_MS);
+    next_dirty = true;
+}
+
+void Pic::EeDev::service(cycles now)
+{
+    (void)now;
+    p->eeprom[addr] = data;
+    p->reg[R_EECON1] &= ~0x02;
+    p->reg[R_PIR2] |= F_EE;
+}
+
+} // namespace sim
@@ -0,0 +1,253 @@
+/*
+ * File:   pic.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// Register-level model of the PIC16F877A for running the firmwares on a
+// Linux host. The firmware is compiled as C++ against sim/xc.h, where
+// every SFR and SFR bit is an object whose reads and writes land in
+// Pic::read() / Pic::write(). Time is counted in instruction cycles
+// (Tcy = 200 ns at 20 MHz):
+//
+//  - each SFR access costs SFR_ACCESS_CYCLES; plain C between accesses is
+//    free, so runtimes are dominated by delays and peripheral waits
+//  - __delay_ms/__delay_us advance time exactly
+//  - a register read repeatedly with the same value is a polling loop and
+//    fast-forwards to the next peripheral event
+//  - NOP() is an idle hint: the scheduler calls it when nothing is due, so
+//    it also fast-forwards
+//
+// On-chip peripherals (ports, Timer1, Timer2, ADC, USART, MSSP I2C master,
+// data EEPROM, interrupts, SLEEP) live here; external parts attach through
+// Device, the pin hooks, the I2C bus and the USART hooks.
+
+#ifndef SIM_PIC_H
+#define SIM_PIC_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+typedef uint64_t cycles;
+
+const cycles NEVER = ~(cycles)0;
+const double FOSC = 20e6;
+const double TCY = 4.0 / FOSC;                 // seconds per cycle
+const cycles SFR_ACCESS_CYCLES = 2;
+const cycles ISR_ENTRY_CYCLES = 20;            // latency plus context save
+const cycles ISR_EXIT_CYCLES = 12;
+
+inline cycles from_us(double us) { return (cycles)(us * 1e-6 / TCY + 0.5); }
+inline cycles from_ms(double ms) { return (cycles)(ms * 1e-3 / TCY + 0.5); }
+inline double to_us(cycles c) { return c * TCY * 1e6; }
+inline double to_ms(cycles c) { return c * TCY * 1e3; }
+
+// Thrown out of the firmware when the run reaches its end time
+struct Stop {};
+
+// Something with timed behaviour. Set `due` (and call Pic::reschedule)
+// to be serviced when simulated time reaches it.
+struct Device {
+    cycles due = NEVER;
+    virtual void service(cycles now) = 0;
+    virtual ~Device() {}
+};
+
+// I2C slave seen by the MSSP master, byte level
+struct I2cSlave {
+    virtual uint8_t address() const = 0;      // 7-bit
+    virtual bool busy() const { return false; }   // NACKs its address (e.g. EEPROM write cycle)
+    virtual void start(bool read) = 0;        // addressed after (repeated) START
+    virtual bool write(uint8_t b) = 0;        // returns ACK
+    virtual uint8_t read() = 0;
+    virtual void master_ack(bool ack) { (void)ack; }
+    virtual void stop() {}
+    virtual ~I2cSlave() {}
+};
+
+enum Port { PA, PB, PC, PD, PE, NPORTS };
+
+struct Violation {
+    cycles at;               // first occurrence
+    std::string source;
+    std::string message;
+    unsigned long count;
+};
+
+class Pic {
+public:
+    Pic();
+
+    cycles now = 0;
+    cycles end = NEVER;
+
+    uint8_t read(uint16_t addr);
+    void write(uint16_t addr, uint8_t v);
+    uint8_t peek(uint16_t addr);          // read without cost or side effects
+    void modify(uint16_t addr, uint8_t mask, uint8_t bits);   // bcf/bsf
+
+    void delay(cycles n);        // __delay_*
+    void idle();                 // NOP(): jump to the next event
+    void sleep();                // SLEEP()
+    void run_until(cycles t);    // advance, servicing devices and interrupts
+
+    // Devices and events
+    void attach(Device *d);
+    void reschedule() { next_dirty = true; }
+
+    // Pins: outputs as driven by the firmware, inputs supplied by models
+    uint8_t latch[NPORTS] = {};
+    uint8_t tris[NPORTS] = {0x3F, 0xFF, 0xFF, 0xFF, 0x07};
+    uint8_t outputs(int port) const { return latch[port] & ~tris[port]; }
+    bool pin_out(int port, int bit) const { return (outputs(port) >> bit) & 1; }
+    // (port, changed mask) after any PORT/TRIS write
+    std::vector<std::function<void(int, uint8_t)>> on_pins;
+    // drivers return the pins they drive in *mask and the levels
+    std::vector<std::function<uint8_t(int, uint8_t *)>> pin_drivers;
+    uint8_t inputs(int port);
+
+    // Analog inputs AN0-AN7 in volts (Vref+ = VDD = 5 V)
+    double analog[8] = {};
+    std::function<double(int, cycles)> analog_source;   // overrides analog[] when set
+    // Digital noise coupled into a conversion while the core runs, in LSB
+    // rms, scaled by the fraction of the conversion spent awake (a
+    // conversion done asleep is exact). Off by default; seeded, so runs
+    // repeat.
+    double adc_noise_lsb = 0;
+
+    // USART: bytes leaving TX at end of stop bit; rx_byte() queues an
+    // arriving byte sent at `baud` and returns when its stop bit ends
+    std::vector<std::function<void(uint8_t, cycles)>> on_tx;
+    cycles rx_byte(uint8_t b, double baud);
+    double baud() const;
+    cycles byte_cycles() const;                  // 10 bits at the board's baud
+
+    // I2C
+    std::vector<I2cSlave *> i2c_bus;
+
+    // Data EEPROM (256 bytes)
+    uint8_t eeprom[256];
+    uint8_t eeprom_read(uint8_t a);
+    void eeprom_write(uint8_t a, uint8_t v);
+
+    // Statistics
+    cycles sleep_cycles = 0;
+    cycles asleep() const { return sleep_cycles + (sleeping ? now - sleep_from : 0); }
+    unsigned long isr_count = 0;
+    unsigned long sfr_accesses = 0;
+    // Peripheral activity, for the energy model (energy.h)
+    cycles adc_cycles = 0;        // conversions
+    cycles mssp_cycles = 0;       // I2C bus operations
+    cycles tx_cycles = 0;         // TSR shifting bytes out
+    cycles rx_cycles = 0;         // bytes arriving on RX
+    std::vector<Violation> violations;
+    void violation(const std::string &source, const std::string &msg);
+
+    bool trace = false;
+
+private:
+    uint8_t reg[0x200] = {};
+    std::vector<Device *> devices;
+    cycles next_event = NEVER;
+    bool next_dirty = true;
+    bool in_isr = false;
+    bool sleeping = false;
+    cycles sleep_from = 0, sleep_to = 0;    // the last (or current) SLEEP
+
+    uint16_t spin_addr = 0xFFFF;
+    uint8_t spin_value = 0;
+    unsigned spin_count = 0;
+
+    void access();
+    void step_to(cycles t);
+    cycles next_due();
+    bool irq_pending(bool for_wake);
+    void check_irq();
+    void pins_changed(int port, uint8_t before);
+
+    // Timer1
+    cycles t1_base = 0;          // time TMR1 was last rebased
+    uint16_t t1_start = 0;       // value at t1_base
+    bool t1_running() const;
+    bool t1_async() const;
+    double t1_period() const;    // cycles per count
+    uint16_t t1_value();
+    void t1_rebase();
+    struct Timer1Dev : Device { Pic *p; void service(cycles now) override; } t1dev;
+
+    // Timer2
+    cycles t2_base = 0;
+    struct Timer2Dev : Device { Pic *p; void service(cycles now) override; } t2dev;
+    cycles t2_period() const;    // cycles per TMR2 match
+    uint8_t t2_value();
+    void t2_config();
+
+    // ADC
+    cycles adc_acq_start = 0;
+    cycles adc_conv_start = 0, adc_conv_asleep = 0;
+    uint16_t adc_result = 0;
+    struct AdcDev : Device { Pic *p; void service(cycles now) override; } adcdev;
+    void adc_start();
+    bool adc_pin_analog(int ch) const;
+
+    // USART
+    bool tsr_busy = false;
+    bool txreg_full = false;
+    uint8_t txreg = 0, tsr = 0;
+    uint8_t rx_fifo[2];
+    int rx_count = 0;
+    struct RxPending { cycles at; uint8_t b; bool ferr; };
+    std::vector<RxPending> rx_pending;
+    struct UsartDev : Device { Pic *p; cycles tx_done = NEVER; void service(cycles now) override; } usartdev;
+    void usart_schedule();
+
+    // MSSP I2C master
+    enum I2cOp { I2C_IDLE, I2C_START, I2C_RSTART, I2C_STOP, I2C_TX, I2C_RX, I2C_ACK };
+    I2cOp i2c_op = I2C_IDLE;
+    I2cSlave *i2c_target = nullptr;
+    bool i2c_addr_phase = false;
+    struct MsspDev : Device { Pic *p; void service(cycles now) override; } msspdev;
+    cycles i2c_bit() const;
+    void i2c_begin(I2cOp op, cycles bits);
+
+    // EEPROM write cycle
+    struct EeDev : Device { Pic *p; uint8_t addr, data; void service(cycles now) override; } eedev;
+    uint8_t ee_unlock = 0;
+    void ee_wait();
+};
+
+extern Pic pic;
+
+// ---------------- SFR objects used by sim/xc.h ----------------
+
+struct Sfr {
+    uint16_t addr;
+    operator uint8_t() const { return pic.read(addr); }
+    const Sfr &operator=(unsigned v) const { pic.write(addr, (uint8_t)v); return *this; }
+    const Sfr &operator=(const Sfr &o) const { return *this = (unsigned)(uint8_t)o; }
+    const Sfr &operator|=(unsigned v) const { return *this = pic.read(addr) | v; }
+    const Sfr &operator&=(unsigned v) const { return *this = pic.read(addr) & v; }
+    const Sfr &operator^=(unsigned v) const { return *this = pic.read(addr) ^ v; }
+    const Sfr &operator+=(unsigned v) const { return *this = pic.read(addr) + v; }
+    const Sfr &operator-=(unsigned v) const { return *this = pic.read(addr) - v; }
+};
+
+struct SfrBit {
+    uint16_t addr;
+    uint8_t bit;
+    operator uint8_t() const { return (pic.read(addr) >> bit) & 1; }
+    const SfrBit &operator=(unsigned v) const {
+        pic.modify(addr, (uint8_t)(1 << bit), v ? 0xFF : 0x00);
+        return *this;
+    }
+    const SfrBit &operator=(const SfrBit &o) const { return *this = (unsigned)(uint8_t)o; }
+};
+
+} // namespace sim
+
+#endif
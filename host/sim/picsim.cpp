@@ -0,0 +1,518 @@
+/*
+ * File:   picsim.cpp
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// Runs one firmware on its simulated board. Built once per firmware by
+// host/Makefile (sim_battery, sim_clock, ...), with SIM_BOARD naming the
+// board preset.
+//
+//   sim_<board> [-t time] [-s script] [-e eeprom.bin] [-x ext.bin]
+//               [-u uart.bin] [-b bench.csv] [-n lsb] [-p power.txt]
+//               [-c mAh] [-w energy.csv] [-v]
+//
+//   -t  simulated run time (default 10s); times take us/ms/s/m/h suffixes
+//   -s  stimulus script, one "<time> <command> [args]" per line, where
+//       time is absolute or "+time" after the previous line:
+//         adc <ch> <volts>          set an analog input
+//         ramp <ch> <volts> <dur>   slew an analog input linearly
+//         press <button> [dur]      press and release (default 100ms)
+//         hold <button> / release <button>
+//         key <c> [dur]             keypad key (default 100ms)
+//         tag <id> [hold]           RFID card, 10 hex digits or 12 chars; held
+//                                   for hold, the reader re-sends it every 100ms
+//         uart <text>               bytes into RX (\r \n \xHH escapes)
+//         rtc <hh:mm:ss> [dd/mm/yy] [halted]
+//         lcd                       print the display
+//         measure <name> <cond>     time the stimulus above (see bench.h)
+//         stop                      end the run here
+//       and "repeat <count> <interval>" ... "end" runs the lines between
+//       count times, interval apart, their times counted from the start
+//       of each pass
+//   -e  data EEPROM image, loaded if present and saved at the end
+//   -x  the same for the board's I2C EEPROM (rfid: 24C32 journal)
+//   -u  write every byte the firmware transmits to this file
+//   -b  append the p50/p99/max of every measured scenario to this CSV
+//   -n  ADC noise while the core runs, LSB rms (conversions asleep are clean)
+//   -p  current table overriding the defaults in energy.cpp, "<name> <mA>"
+//   -c  battery capacity, mAh: print the current breakdown and battery life
+//   -w  append the average current (and life, with -c) to this CSV
+//   -v  trace events and violations as they happen
+//
+// Prints the final display, transmitted text, outputs, statistics, the
+// average supply current (see energy.h) and every timing/protocol
+// violation the models detected.
+
+#include "board.h"
+#include "bench.h"
+#include "energy.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+
+#ifndef SIM_BOARD
+#error "build with -DSIM_BOARD=\"<board>\""
+#endif
+
+void pic_main(void);
+
+using namespace sim;
+
+static std::unique_ptr<Board> board;
+static std::unique_ptr<Bench> bench;
+static std::unique_ptr<Energy> energy;
+static cycles stimulus_end;     // when the last stimulus finished arriving
+static bool verbose;
+
+static bool parse_time(const std::string &s, cycles *out)
+{
+    char *end;
+    double v = strtod(s.c_str(), &end);
+    if (end == s.c_str() || v < 0)
+        return false;
+    std::string unit(end);
+    double scale;
+    if (unit == "" || unit == "s")
+        scale = 1;
+    else if (unit == "ms")
+        scale = 1e-3;
+    else if (unit == "us")
+        scale = 1e-6;
+    else if (unit == "m")
+        scale = 60;
+    else if (unit == "h")
+        scale = 3600;
+    else
+        return false;
+    *out = (cycles)(v * scale / TCY + 0.5);
+    return true;
+}
+
+static std::string escape(const std::vector<uint8_t> &b)
+{
+    std::string s;
+    for (uint8_t c : b) {
+        char buf[8];
+        if (c == '\r')
+            s += "\\r";
+        else if (c == '\n')
+            s += "\\n";
+        else if (c >= 0x20 && c < 0x7F && c != '\\')
+            s += (char)c;
+        else {
+            snprintf(buf, sizeof buf, "\\x%02X", c);
+            s += buf;
+        }
+    }
+    return s;
+}
+
+static std::string unescape(const std::string &s)
+{
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] != '\\' || i + 1 == s.size()) {
+            out += s[i];
+            continue;
+        }
+        char c = s[++i];
+        if (c == 'r')
+            out += '\r';
+        else if (c == 'n')
+            out += '\n';
+        else if (c == 'x' && i + 2 < s.size() + 1) {
+            out += (char)strtoul(s.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else
+            out += c;
+    }
+    return out;
+}
+
+// ---------------- stimulus script ----------------
+
+struct Event {
+    int line;
+    std::vector<std::string> argv;
+};
+
+class Script : public Device {
+public:
+    std::multimap<cycles, Event> events;
+
+    void add(cycles at, const Event &e)
+    {
+        events.insert({ at, e });
+        due = events.begin()->first;
+        pic.reschedule();
+    }
+
+    void service(cycles now) override
+    {
+        while (!events.empty() && events.begin()->first <= now) {
+            Event e = events.begin()->second;
+            events.erase(events.begin());
+            run(e);
+        }
+        due = events.empty() ? NEVER : events.begin()->first;
+    }
+
+private:
+    void run(const Event &e);
+};
+
+static Script script;
+
+static void print_lcd(const char *prefix)
+{
+    if (!board->lcd)
+        return;
+    printf("%s|%s|\n", prefix, board->lcd->line(0).c_str());
+    printf("%*s|%s|\n", (int)strlen(prefix), "", board->lcd->line(1).c_str());
+}
+
+void Script::run(const Event &e)
+{
+    const std::vector<std::string> &a = e.argv;
+    const std::string &cmd = a[0];
+    cycles dur = from_ms(100);
+    if (verbose)
+        fprintf(stderr, "%10.3f ms  script:%d: %s\n", to_ms(pic.now), e.line, cmd.c_str());
+    if (cmd != "measure" && cmd != "lcd")
+        stimulus_end = pic.now;
+
+    if (cmd == "adc") {
+        board->analog.set(atoi(a[1].c_str()), atof(a[2].c_str()));
+    } else if (cmd == "ramp") {
+        parse_time(a[3], &dur);
+        board->analog.ramp(atoi(a[1].c_str()), atof(a[2].c_str()), dur);
+    } else if (cmd == "press" || cmd == "hold") {
+        board->buttons.set(a[1], true);
+        if (cmd == "press") {
+            if (a.size() > 2)
+                parse_time(a[2], &dur);
+            add(pic.now + dur, { e.line, { "release", a[1] } });
+        }
+    } else if (cmd == "release") {
+        board->buttons.set(a[1], false);
+    } else if (cmd == "key") {
+        if (a.size() > 2)
+            parse_time(a[2], &dur);
+        board->keypad->press(a[1][0]);
+        add(pic.now + dur, { e.line, { "key-up" } });
+    } else if (cmd == "key-up") {
+        board->keypad->release();
+    } else if (cmd == "tag") {
+        cycles hold = 0;
+        if (a.size() > 2)
+            parse_time(a[2], &hold);
+        stimulus_end = board->rfid->present(a[1], hold);
+    } else if (cmd == "uart") {
+        std::string text;
+        for (size_t i = 1; i < a.size(); i++)
+            text += (i > 1 ? " " : "") + a[i];
+        for (char c : unescape(text))
+            stimulus_end = pic.rx_byte((uint8_t)c, pic.baud());
+    } else if (cmd == "rtc") {
+        int hh = 0, mm = 0, ss = 0, dd = 1, mo = 1, yy = 0;
+        bool running = true;
+        sscanf(a[1].c_str(), "%d:%d:%d", &hh, &mm, &ss);
+        for (size_t i = 2; i < a.size(); i++) {
+            if (a[i] == "halted")
+                running = false;
+            else
+                sscanf(a[i].c_str(), "%d/%d/%d", &dd, &mo, &yy);
+        }
+        board->rtc->set(hh, mm, ss, dd, mo, yy, running);
+    } else if (cmd == "lcd") {
+        char prefix[32];
+        snprintf(prefix, sizeof prefix, "%10.3f s  ", to_ms(pic.now) / 1000);
+        print_lcd(prefix);
+    } else if (cmd == "measure") {
+        bench->start(std::vector<std::string>(a.begin() + 1, a.end()), std::max(pic.now, stimulus_end));
+    } else if (cmd == "stop") {
+        pic.end = pic.now;
+    }
+}
+
+static std::vector<std::string> words(std::string text)
+{
+    text = text.substr(0, text.find('#'));
+    std::istringstream ss(text);
+    std::vector<std::string> argv;
+    std::string w;
+    while (ss >> w)
+        argv.push_back(w);
+    return argv;
+}
+
+// One "<time> <command> [args]" line; absolute times count from `base`
+static bool parse_line(const char *path, int n, std::vector<std::string> argv, cycles base, cycles *last)
+{
+    static const std::map<std::string, int> nargs = {
+        { "adc", 2 }, { "ramp", 3 }, { "press", 1 }, { "hold", 1 }, { "release", 1 },
+        { "key", 1 }, { "tag", 1 }, { "uart", 1 }, { "rtc", 1 }, { "lcd", 0 },
+        { "measure", 2 }, { "stop", 0 },
+    };
+    cycles at;
+    bool rel = argv[0][0] == '+';
+    if (argv.size() < 2 || !parse_time(argv[0].substr(rel), &at)) {
+        fprintf(stderr, "%s:%d: expected \"<time> <command>\"\n", path, n);
+        return false;
+    }
+    at += rel ? *last : base;
+    *last = at;
+    argv.erase(argv.begin());
+
+    auto it = nargs.find(argv[0]);
+    const char *missing = nullptr;
+    if (it == nargs.end()) {
+        fprintf(stderr, "%s:%d: unknown command '%s'\n", path, n, argv[0].c_str());
+        return false;
+    }
+    if ((int)argv.size() - 1 < it->second) {
+        fprintf(stderr, "%s:%d: '%s' needs %d argument(s)\n", path, n, argv[0].c_str(), it->second);
+        return false;
+    }
+    if (argv[0] == "key" && !board->keypad)
+        missing = "keypad";
+    else if (argv[0] == "tag" && !board->rfid)
+        missing = "RFID reader";
+    else if (argv[0] == "rtc" && !board->rtc)
+        missing = "RTC";
+    if (missing) {
+        fprintf(stderr, "%s:%d: board '%s' has no %s\n", path, n, board->name.c_str(), missing);
+        return false;
+    }
+    if (argv[0] == "measure") {
+        std::string err = bench->check(std::vector<std::string>(argv.begin() + 1, argv.end()));
+        if (!err.empty()) {
+            fprintf(stderr, "%s:%d: %s\n", path, n, err.c_str());
+            return false;
+        }
+    }
+    script.add(at, { n, argv });
+    return true;
+}
+
+static bool load_script(const char *path)
+{
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    std::string text;
+    cycles last = 0, every = 0;
+    long count = -1;                          // >= 0 inside repeat ... end
+    std::vector<std::pair<int, std::vector<std::string>>> block;
+    for (int n = 1; std::getline(in, text); n++) {
+        std::vector<std::string> argv = words(text);
+        if (argv.empty())
+            continue;
+        if (argv[0] == "repeat") {
+            if (count >= 0 || argv.size() != 3 || (count = atol(argv[1].c_str())) < 1 ||
+                !parse_time(argv[2], &every) || !every) {
+                fprintf(stderr, "%s:%d: expected \"repeat <count> <interval>\" outside a block\n", path, n);
+                return false;
+            }
+            block.clear();
+        } else if (argv[0] == "end") {
+            if (count < 0) {
+                fprintf(stderr, "%s:%d: 'end' without 'repeat'\n", path, n);
+                return false;
+            }
+            cycles start = last;
+            for (long k = 0; k < count; k++) {
+                cycles base = start + k * every;
+                last = base;
+                for (auto &l : block)
+                    if (!parse_line(path, l.first, l.second, base, &last))
+                        return false;
+            }
+            last = start + count * every;
+            count = -1;
+        } else if (count >= 0) {
+            block.push_back({ n, argv });
+        } else if (!parse_line(path, n, argv, 0, &last)) {
+            return false;
+        }
+    }
+    if (count >= 0) {
+        fprintf(stderr, "%s: 'repeat' without 'end'\n", path);
+        return false;
+    }
+    return true;
+}
+
+// ---------------- main ----------------
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [-t time] [-s script] [-e eeprom.bin] [-x ext.bin] [-u uart.bin] "
+            "[-b bench.csv] [-n lsb] [-p power.txt] [-c mAh] [-w energy.csv] [-v]\n", prog);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    cycles run = from_ms(10000);
+    const char *script_path = nullptr, *eeprom_path = nullptr, *uart_path = nullptr;
+    const char *bench_path = nullptr, *ext_path = nullptr;
+    const char *power_path = nullptr, *energy_path = nullptr;
+    double adc_noise = 0, capacity = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "t:s:e:x:u:b:n:p:c:w:v")) != -1) {
+        switch (opt) {
+        case 't':
+            if (!parse_time(optarg, &run))
+                usage(argv[0]);
+            break;
+        case 's': script_path = optarg; break;
+        case 'e': eeprom_path = optarg; break;
+        case 'x': ext_path = optarg; break;
+        case 'u': uart_path = optarg; break;
+        case 'b': bench_path = optarg; break;
+        case 'n': adc_noise = atof(optarg); break;
+        case 'p': power_path = optarg; break;
+        case 'c': capacity = atof(optarg); break;
+        case 'w': energy_path = optarg; break;
+        case 'v': verbose = true; break;
+        default: usage(argv[0]);
+        }
+    }
+
+    board = board_create(SIM_BOARD);
+    pic.adc_noise_lsb = adc_noise;
+    bench.reset(new Bench(*board));
+    energy.reset(new Energy(*board));
+    if (power_path) {
+        std::string err = energy->load(power_path);
+        if (!err.empty()) {
+            fprintf(stderr, "%s\n", err.c_str());
+            return 2;
+        }
+    }
+    pic.end = run;
+    pic.trace = verbose;
+    pic.attach(&script);
+    if (script_path && !load_script(script_path))
+        return 2;
+
+    if (eeprom_path) {
+        FILE *f = fopen(eeprom_path, "rb");
+        if (f) {
+            if (fread(pic.eeprom, 1, sizeof pic.eeprom, f) != sizeof pic.eeprom)
+                fprintf(stderr, "%s: short EEPROM image\n", eeprom_path);
+            fclose(f);
+        }
+    }
+    if (ext_path && !board->ext_eeprom) {
+        fprintf(stderr, "board '%s' has no I2C EEPROM\n", board->name.c_str());
+        return 2;
+    }
+    if (ext_path) {
+        std::vector<uint8_t> &m = board->ext_eeprom->mem;
+        FILE *f = fopen(ext_path, "rb");
+        if (f) {
+            if (fread(m.data(), 1, m.size(), f) != m.size())
+                fprintf(stderr, "%s: short EEPROM image\n", ext_path);
+            fclose(f);
+        }
+    }
+
+    std::vector<uint8_t> tx;
+    FILE *uart_out = nullptr;
+    if (uart_path && !(uart_out = fopen(uart_path, "wb"))) {
+        perror(uart_path);
+        return 2;
+    }
+    pic.on_tx.push_back([&](uint8_t b, cycles) {
+        tx.push_back(b);
+        if (uart_out)
+            fputc(b, uart_out);
+    });
+    if (verbose) {
+        board->outputs.on_change.push_back([](const Outputs::Pin &p, cycles now) {
+            fprintf(stderr, "%10.3f ms  %s %s\n", to_ms(now), p.name.c_str(), p.on ? "on" : "off");
+        });
+    }
+
+    bool returned = false;
+    try {
+        pic_main();
+        returned = true;
+    } catch (Stop &) {
+    }
+    bench->finish();
+
+    printf("board       %s (%s)\n", board->name.c_str(), board->firmware.c_str());
+    printf("simulated   %.3f s, %lu SFR accesses, %lu interrupts, %.1f %% asleep\n",
+           to_ms(pic.now) / 1000, pic.sfr_accesses, pic.isr_count,
+           pic.now ? 100.0 * pic.sleep_cycles / pic.now : 0.0);
+    if (returned)
+        printf("            main() returned at %.3f ms\n", to_ms(pic.now));
+    print_lcd("lcd         ");
+    if (board->lcd)
+        printf("            %lu commands, %lu characters, %lu dropped\n",
+               board->lcd->commands, board->lcd->chars, board->lcd->dropped);
+    if (!tx.empty()) {
+        std::vector<uint8_t> head(tx.begin(), tx.begin() + std::min<size_t>(tx.size(), 160));
+        printf("uart tx     %zu bytes: \"%s\"%s\n", tx.size(), escape(head).c_str(),
+               tx.size() > head.size() ? "..." : "");
+    }
+    for (auto &p : board->outputs.pins)
+        printf("%-11s %s, on %.3f s, %lu edges\n", p.name.c_str(), p.on ? "on" : "off",
+               to_ms(board->outputs.on_time(p)) / 1000, p.edges);
+    if (board->rtc)
+        printf("rtc         %s\n", board->rtc->time_string().c_str());
+    if (board->rfid)
+        printf("rfid        %lu reads\n", board->rfid->reads);
+    if (board->ext_eeprom)
+        printf("24c32       %lu page writes, %lu bytes\n", board->ext_eeprom->page_writes,
+               board->ext_eeprom->bytes_written);
+
+    if (!bench->empty()) {
+        printf("latency\n");
+        bench->print(stdout);
+    }
+    printf("energy      %.3f mA average, %.1f %% awake\n", energy->average_ma(),
+           pic.now ? 100.0 * (pic.now - pic.asleep()) / pic.now : 0.0);
+    if (capacity > 0)
+        energy->print(stdout, capacity);
+    printf("violations  %zu\n", pic.violations.size());
+    for (auto &v : pic.violations)
+        printf("  %10.3f ms  %s: %s%s\n", to_ms(v.at), v.source.c_str(), v.message.c_str(),
+               v.count > 1 ? (" (x" + std::to_string(v.count) + ")").c_str() : "");
+
+    if (uart_out)
+        fclose(uart_out);
+    if (bench_path && !bench->save(bench_path))
+        perror(bench_path);
+    if (energy_path && !energy->save(energy_path, capacity))
+        perror(energy_path);
+    if (eeprom_path) {
+        FILE *f = fopen(eeprom_path, "wb");
+        if (!f || fwrite(pic.eeprom, 1, sizeof pic.eeprom, f) != sizeof pic.eeprom)
+            perror(eeprom_path);
+        if (f)
+            fclose(f);
+    }
+    if (ext_path) {
+        std::vector<uint8_t> &m = board->ext_eeprom->mem;
+        FILE *f = fopen(ext_path, "wb");
+        if (!f || fwrite(m.data(), 1, m.size(), f) != m.size())
+            perror(ext_path);
+        if (f)
+            fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,265 @@
+/*
+ * File:   xc.h
+ * Author: Rakesh B
+ *
+ * Created on October 22, 2026, 9:00 AM
+ */
+
+// Stand-in for the XC8 <xc.h> when a firmware is compiled for the host
+// simulator (g++ -x c++ -Ihost/sim). Registers and bits are sim::Sfr /
+// sim::SfrBit objects, so `PORTB = 0x10`, `RB0 = 1`, `while(!TRMT)` and
+// `ADCON0 |= 0x04` all go through the PIC model with their side effects.
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include <stdint.h>
+#include "pic.h"
+
+// The firmware's main() runs on its own stack of simulated time
+#define main pic_main
+void pic_main(void);
+
+#define __interrupt(...)
+#define __delay_ms(x) sim::pic.delay((sim::cycles)((double)(x) * (_XTAL_FREQ / 4000.0)))
+#define __delay_us(x) sim::pic.delay((sim::cycles)((double)(x) * (_XTAL_FREQ / 4000000.0)))
+#define NOP() sim::pic.idle()
+#define SLEEP() sim::pic.sleep()
+#define CLRWDT() ((void)0)
+#define ei() (GIE = 1)
+#define di() (GIE = 0)
+
+inline unsigned char eeprom_read(unsigned char a) { return sim::pic.eeprom_read(a); }
+inline void eeprom_write(unsigned char a, unsigned char v) { sim::pic.eeprom_write(a, v); }
+
+inline constexpr sim::Sfr TMR0{0x001};
+inline constexpr sim::Sfr STATUS{0x003};
+inline constexpr sim::SfrBit C{0x003, 0};
+inline constexpr sim::SfrBit DC{0x003, 1};
+inline constexpr sim::SfrBit Z{0x003, 2};
+inline constexpr sim::SfrBit nPD{0x003, 3};
+inline constexpr sim::SfrBit nTO{0x003, 4};
+inline constexpr sim::SfrBit RP0{0x003, 5};
+inline constexpr sim::SfrBit RP1{0x003, 6};
+inline constexpr sim::SfrBit IRP{0x003, 7};
+inline constexpr sim::Sfr PORTA{0x005};
+inline constexpr sim::SfrBit RA0{0x005, 0};
+inline constexpr sim::SfrBit RA1{0x005, 1};
+inline constexpr sim::SfrBit RA2{0x005, 2};
+inline constexpr sim::SfrBit RA3{0x005, 3};
+inline constexpr sim::SfrBit RA4{0x005, 4};
+inline constexpr sim::SfrBit RA5{0x005, 5};
+inline constexpr sim::Sfr PORTB{0x006};
+inline constexpr sim::SfrBit RB0{0x006, 0};
+inline constexpr sim::SfrBit RB1{0x006, 1};
+inline constexpr sim::SfrBit RB2{0x006, 2};
+inline constexpr sim::SfrBit RB3{0x006, 3};
+inline constexpr sim::SfrBit RB4{0x006, 4};
+inline constexpr sim::SfrBit RB5{0x006, 5};
+inline constexpr sim::SfrBit RB6{0x006, 6};
+inline constexpr sim::SfrBit RB7{0x006, 7};
+inline constexpr sim::Sfr PORTC{0x007};
+inline constexpr sim::SfrBit RC0{0x007, 0};
+inline constexpr sim::SfrBit RC1{0x007, 1};
+inline constexpr sim::SfrBit RC2{0x007, 2};
+inline constexpr sim::SfrBit RC3{0x007, 3};
+inline constexpr sim::SfrBit RC4{0x007, 4};
+inline constexpr sim::SfrBit RC5{0x007, 5};
+inline constexpr sim::SfrBit RC6{0x007, 6};
+inline constexpr sim::SfrBit RC7{0x007, 7};
+inline constexpr sim::Sfr PORTD{0x008};
+inline constexpr sim::SfrBit RD0{0x008, 0};
+inline constexpr sim::SfrBit RD1{0x008, 1};
+inline constexpr sim::SfrBit RD2{0x008, 2};
+inline constexpr sim::SfrBit RD3{0x008, 3};
+inline constexpr sim::SfrBit RD4{0x008, 4};
+inline constexpr sim::SfrBit RD5{0x008, 5};
+inline constexpr sim::SfrBit RD6{0x008, 6};
+inline constexpr sim::SfrBit RD7{0x008, 7};
+inline constexpr sim::Sfr PORTE{0x009};
+inline constexpr sim::SfrBit RE0{0x009, 0};
+inline constexpr sim::SfrBit RE1{0x009, 1};
+inline constexpr sim::SfrBit RE2{0x009, 2};
+inline constexpr sim::Sfr INTCON{0x00B};
+inline constexpr sim::SfrBit RBIF{0x00B, 0};
+inline constexpr sim::SfrBit INTF{0x00B, 1};
+inline constexpr sim::SfrBit T0IF{0x00B, 2};
+inline constexpr sim::SfrBit RBIE{0x00B, 3};
+inline constexpr sim::SfrBit INTE{0x00B, 4};
+inline constexpr sim::SfrBit T0IE{0x00B, 5};
+inline constexpr sim::SfrBit PEIE{0x00B, 6};
+inline constexpr sim::SfrBit GIE{0x00B, 7};
+inline constexpr sim::Sfr PIR1{0x00C};
+inline constexpr sim::SfrBit TMR1IF{0x00C, 0};
+inline constexpr sim::SfrBit TMR2IF{0x00C, 1};
+inline constexpr sim::SfrBit CCP1IF{0x00C, 2};
+inline constexpr sim::SfrBit SSPIF{0x00C, 3};
+inline constexpr sim::SfrBit TXIF{0x00C, 4};
+inline constexpr sim::SfrBit RCIF{0x00C, 5};
+inline constexpr sim::SfrBit ADIF{0x00C, 6};
+inline constexpr sim::SfrBit PSPIF{0x00C, 7};
+inline constexpr sim::Sfr PIR2{0x00D};
+inline constexpr sim::SfrBit CCP2IF{0x00D, 0};
+inline constexpr sim::SfrBit BCLIF{0x00D, 3};
+inline constexpr sim::SfrBit EEIF{0x00D, 4};
+inline constexpr sim::Sfr TMR1L{0x00E};
+inline constexpr sim::Sfr TMR1H{0x00F};
+inline constexpr sim::Sfr T1CON{0x010};
+inline constexpr sim::SfrBit TMR1ON{0x010, 0};
+inline constexpr sim::SfrBit TMR1CS{0x010, 1};
+inline constexpr sim::SfrBit nT1SYNC{0x010, 2};
+inline constexpr sim::SfrBit T1OSCEN{0x010, 3};
+inline constexpr sim::SfrBit T1CKPS0{0x010, 4};
+inline constexpr sim::SfrBit T1CKPS1{0x010, 5};
+inline constexpr sim::Sfr TMR2{0x011};
+inline constexpr sim::Sfr T2CON{0x012};
+inline constexpr sim::SfrBit T2CKPS0{0x012, 0};
+inline constexpr sim::SfrBit T2CKPS1{0x012, 1};
+inline constexpr sim::SfrBit TMR2ON{0x012, 2};
+inline constexpr sim::SfrBit TOUTPS0{0x012, 3};
+inline constexpr sim::SfrBit TOUTPS1{0x012, 4};
+inline constexpr sim::SfrBit TOUTPS2{0x012, 5};
+inline constexpr sim::SfrBit TOUTPS3{0x012, 6};
+inline constexpr sim::Sfr SSPBUF{0x013};
+inline constexpr sim::Sfr SSPCON{0x014};
+inline constexpr sim::SfrBit SSPM0{0x014, 0};
+inline constexpr sim::SfrBit SSPM1{0x014, 1};
+inline constexpr sim::SfrBit SSPM2{0x014, 2};
+inline constexpr sim::SfrBit SSPM3{0x014, 3};
+inline constexpr sim::SfrBit CKP{0x014, 4};
+inline constexpr sim::SfrBit SSPEN{0x014, 5};
+inline constexpr sim::SfrBit SSPOV{0x014, 6};
+inline constexpr sim::SfrBit WCOL{0x014, 7};
+inline constexpr sim::Sfr RCSTA{0x018};
+inline constexpr sim::SfrBit RX9D{0x018, 0};
+inline constexpr sim::SfrBit OERR{0x018, 1};
+inline constexpr sim::SfrBit FERR{0x018, 2};
+inline constexpr sim::SfrBit ADDEN{0x018, 3};
+inline constexpr sim::SfrBit CREN{0x018, 4};
+inline constexpr sim::SfrBit SREN{0x018, 5};
+inline constexpr sim::SfrBit RX9{0x018, 6};
+inline constexpr sim::SfrBit SPEN{0x018, 7};
+inline constexpr sim::Sfr TXREG{0x019};
+inline constexpr sim::Sfr RCREG{0x01A};
+inline constexpr sim::Sfr ADRESH{0x01E};
+inline constexpr sim::Sfr ADCON0{0x01F};
+inline constexpr sim::SfrBit ADON{0x01F, 0};
+inline constexpr sim::SfrBit GO_nDONE{0x01F, 2};
+inline constexpr sim::SfrBit GO{0x01F, 2};
+inline constexpr sim::SfrBit GO_DONE{0x01F, 2};
+inline constexpr sim::SfrBit CHS0{0x01F, 3};
+inline constexpr sim::SfrBit CHS1{0x01F, 4};
+inline constexpr sim::SfrBit CHS2{0x01F, 5};
+inline constexpr sim::SfrBit ADCS0{0x01F, 6};
+inline constexpr sim::SfrBit ADCS1{0x01F, 7};
+inline constexpr sim::Sfr OPTION_REG{0x081};
+inline constexpr sim::SfrBit PS0{0x081, 0};
+inline constexpr sim::SfrBit PS1{0x081, 1};
+inline constexpr sim::SfrBit PS2{0x081, 2};
+inline constexpr sim::SfrBit PSA{0x081, 3};
+inline constexpr sim::SfrBit T0SE{0x081, 4};
+inline constexpr sim::SfrBit T0CS{0x081, 5};
+inline constexpr sim::SfrBit INTEDG{0x081, 6};
+inline constexpr sim::SfrBit nRBPU{0x081, 7};
+inline constexpr sim::Sfr TRISA{0x085};
+inline constexpr sim::SfrBit TRISA0{0x085, 0};
+inline constexpr sim::SfrBit TRISA1{0x085, 1};
+inline constexpr sim::SfrBit TRISA2{0x085, 2};
+inline constexpr sim::SfrBit TRISA3{0x085, 3};
+inline constexpr sim::SfrBit TRISA4{0x085, 4};
+inline constexpr sim::SfrBit TRISA5{0x085, 5};
+inline constexpr sim::Sfr TRISB{0x086};
+inline constexpr sim::SfrBit TRISB0{0x086, 0};
+inline constexpr sim::SfrBit TRISB1{0x086, 1};
+inline constexpr sim::SfrBit TRISB2{0x086, 2};
+inline constexpr sim::SfrBit TRISB3{0x086, 3};
+inline constexpr sim::SfrBit TRISB4{0x086, 4};
+inline constexpr sim::SfrBit TRISB5{0x086, 5};
+inline constexpr sim::SfrBit TRISB6{0x086, 6};
+inline constexpr sim::SfrBit TRISB7{0x086, 7};
+inline constexpr sim::Sfr TRISC{0x087};
+inline constexpr sim::SfrBit TRISC0{0x087, 0};
+inline constexpr sim::SfrBit TRISC1{0x087, 1};
+inline constexpr sim::SfrBit TRISC2{0x087, 2};
+inline constexpr sim::SfrBit TRISC3{0x087, 3};
+inline constexpr sim::SfrBit TRISC4{0x087, 4};
+inline constexpr sim::SfrBit TRISC5{0x087, 5};
+inline constexpr sim::SfrBit TRISC6{0x087, 6};
+inline constexpr sim::SfrBit TRISC7{0x087, 7};
+inline constexpr sim::Sfr TRISD{0x088};
+inline constexpr sim::SfrBit TRISD0{0x088, 0};
+inline constexpr sim::SfrBit TRISD1{0x088, 1};
+inline constexpr sim::SfrBit TRISD2{0x088, 2};
+inline constexpr sim::SfrBit TRISD3{0x088, 3};
+inline constexpr sim::SfrBit TRISD4{0x088, 4};
+inline constexpr sim::SfrBit TRISD5{0x088, 5};
+inline constexpr sim::SfrBit TRISD6{0x088, 6};
+inline constexpr sim::SfrBit TRISD7{0x088, 7};
+inline constexpr sim::Sfr TRISE{0x089};
+inline constexpr sim::SfrBit TRISE0{0x089, 0};
+inline constexpr sim::SfrBit TRISE1{0x089, 1};
+inline constexpr sim::SfrBit TRISE2{0x089, 2};
+inline constexpr sim::Sfr PIE1{0x08C};
+inline constexpr sim::SfrBit TMR1IE{0x08C, 0};
+inline constexpr sim::SfrBit TMR2IE{0x08C, 1};
+inline constexpr sim::SfrBit CCP1IE{0x08C, 2};
+inline constexpr sim::SfrBit SSPIE{0x08C, 3};
+inline constexpr sim::SfrBit TXIE{0x08C, 4};
+inline constexpr sim::SfrBit RCIE{0x08C, 5};
+inline constexpr sim::SfrBit ADIE{0x08C, 6};
+inline constexpr sim::SfrBit PSPIE{0x08C, 7};
+inline constexpr sim::Sfr PIE2{0x08D};
+inline constexpr sim::SfrBit CCP2IE{0x08D, 0};
+inline constexpr sim::SfrBit BCLIE{0x08D, 3};
+inline constexpr sim::SfrBit EEIE{0x08D, 4};
+inline constexpr sim::Sfr SSPCON2{0x091};
+inline constexpr sim::SfrBit SEN{0x091, 0};
+inline constexpr sim::SfrBit RSEN{0x091, 1};
+inline constexpr sim::SfrBit PEN{0x091, 2};
+inline constexpr sim::SfrBit RCEN{0x091, 3};
+inline constexpr sim::SfrBit ACKEN{0x091, 4};
+inline constexpr sim::SfrBit ACKDT{0x091, 5};
+inline constexpr sim::SfrBit GCEN{0x091, 7};
+inline constexpr sim::Sfr PR2{0x092};
+inline constexpr sim::Sfr SSPADD{0x093};
+inline constexpr sim::Sfr SSPSTAT{0x094};
+inline constexpr sim::SfrBit BF{0x094, 0};
+inline constexpr sim::SfrBit UA{0x094, 1};
+inline constexpr sim::SfrBit R_nW{0x094, 2};
+inline constexpr sim::SfrBit S{0x094, 3};
+inline constexpr sim::SfrBit P{0x094, 4};
+inline constexpr sim::SfrBit D_nA{0x094, 5};
+inline constexpr sim::SfrBit CKE{0x094, 6};
+inline constexpr sim::SfrBit SMP{0x094, 7};
+inline constexpr sim::Sfr TXSTA{0x098};
+inline constexpr sim::SfrBit TX9D{0x098, 0};
+inline constexpr sim::SfrBit TRMT{0x098, 1};
+inline constexpr sim::SfrBit BRGH{0x098, 2};
+inline constexpr sim::SfrBit SYNC{0x098, 4};
+inline constexpr sim::SfrBit TXEN{0x098, 5};
+inline constexpr sim::SfrBit TX9{0x098, 6};
+inline constexpr sim::SfrBit CSRC{0x098, 7};
+inline constexpr sim::Sfr SPBRG{0x099};
+inline constexpr sim::Sfr CMCON{0x09C};
+inline constexpr sim::Sfr ADRESL{0x09E};
+inline constexpr sim::Sfr ADCON1{0x09F};
+inline constexpr sim::SfrBit PCFG0{0x09F, 0};
+inline constexpr sim::SfrBit PCFG1{0x09F, 1};
+inline constexpr sim::SfrBit PCFG2{0x09F, 2};
+inline constexpr sim::SfrBit PCFG3{0x09F, 3};
+inline constexpr sim::SfrBit ADCS2{0x09F, 6};
+inline constexpr sim::SfrBit ADFM{0x09F, 7};
+inline constexpr sim::Sfr EEDATA{0x10C};
+inline constexpr sim::Sfr EEADR{0x10D};
+inline constexpr sim::Sfr EECON1{0x18C};
+inline constexpr sim::SfrBit RD{0x18C, 0};
+inline constexpr sim::SfrBit WR{0x18C, 1};
+inline constexpr sim::SfrBit WREN{0x18C, 2};
+inline constexpr sim::SfrBit WRERR{0x18C, 3};
+inline constexpr sim::SfrBit EEPGD{0x18C, 7};
+inline constexpr sim::Sfr EECON2{0x18D};
+
+// The only bit the firmwares reach through a *bits structure
+inline constexpr struct { sim::SfrBit ACKSTAT; } SSPCON2bits{{0x091, 6}};
+
+#endif
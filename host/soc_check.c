@@ -0,0 +1,170 @@
+/*
+ * File:   soc_check.c
+ * Author: Rakesh B
+ *
+ * Created on October 28, 2026, 9:00 AM
+ */
+
+// Checks common/soc.c built natively (make -C host soc):
+//
+//  - soc_from_mv() against the piecewise-linear OCV curve each table was
+//    sampled from (10 % steps), every mV from 9 to 16 V: the largest error
+//    must stay within the chemistry's bound, and the result must never
+//    fall as the voltage rises
+//  - soc_update()'s rest detector: seeding, charging, readings that move
+//    by more than SOC_STILL_MV, and the estimate after rest_ms
+//  - soc_full(): 100 % from the cut-off until the pack has rested
+//
+// Prints the error per chemistry and each failed check; exits 1 on any.
+
+#include <math.h>
+#include <stdio.h>
+#include "soc.h"
+
+struct source {
+    const char *name;
+    int mv[11];                 // 0, 10 ... 100 %
+    double bound;               // largest error allowed, %
+};
+
+static const struct source sources[SOC_CHEMISTRIES] = {
+    { "flooded", { 11360, 11510, 11660, 11810, 11960, 12100, 12240, 12370, 12500, 12620, 12730 }, 1.0 },
+    { "agm",     { 11510, 11700, 11860, 12000, 12150, 12290, 12410, 12530, 12650, 12750, 12850 }, 1.5 },
+    { "lifepo4", { 12000, 12800, 12900, 13000, 13100, 13130, 13200, 13250, 13280, 13350, 13600 }, 2.5 },
+};
+
+static int failed;
+
+#define CHECK(cond, what) \
+    do { if (!(cond)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, what); failed++; } } while (0)
+
+static double source_pct(const struct source *s, int mv)
+{
+    if (mv <= s->mv[0])
+        return 0;
+    for (int i = 0; i < 10; i++)
+        if (mv <= s->mv[i + 1])
+            return i * 10 + 10.0 * (mv - s->mv[i]) / (s->mv[i + 1] - s->mv[i]);
+    return 100;
+}
+
+static void check_tables(void)
+{
+    for (int k = 0; k < SOC_CHEMISTRIES; k++) {
+        const struct source *s = &sources[k];
+        double worst = 0;
+        int worst_mv = 0, prev = 0;
+        for (int mv = 9000; mv <= 16000; mv++) {
+            int pct = soc_from_mv(&soc_curves[k], (uint16_t)mv);
+            double e = fabs(pct - source_pct(s, mv));
+            if (e > worst) {
+                worst = e;
+                worst_mv = mv;
+            }
+            if (pct < prev) {
+                printf("FAIL %s: %d %% at %d mV after %d %%\n", s->name, pct, mv, prev);
+                failed++;
+            }
+            prev = pct;
+        }
+        printf("%-8s max error %.2f %% at %d mV (bound %.1f %%)\n", s->name, worst, worst_mv, s->bound);
+        if (worst > s->bound + 1e-9) {
+            printf("FAIL %s: error above the bound\n", s->name);
+            failed++;
+        }
+        CHECK(soc_from_mv(&soc_curves[k], 9000) == 0, "0 % below the curve");
+        CHECK(soc_from_mv(&soc_curves[k], 16000) == 100, "100 % above the curve");
+    }
+}
+
+#define REST_MS 600000UL
+#define STEP_MS 500UL           // sense_task's period
+
+static void check_rest(void)
+{
+    const soc_curve_t *c = &soc_curves[SOC_FLOODED];
+    soc_pack_t p = { 0 };
+    uint32_t t = 0;
+
+    // charging at reset: no estimate until it is off charge
+    CHECK(!soc_update(&p, c, 12600, 1, t, REST_MS), "update while charging");
+    CHECK(p.state == SOC_NONE, "no seed while charging");
+
+    // first reading off charge seeds
+    t += STEP_MS;
+    CHECK(soc_update(&p, c, 12100, 0, t, REST_MS), "seed reported");
+    CHECK(p.state == SOC_SEED && p.pct == soc_from_mv(c, 12100), "seed from the first reading");
+
+    // a load pulls it down by more than SOC_STILL_MV: the estimate holds
+    // and the rest starts over
+    t += STEP_MS;
+    CHECK(!soc_update(&p, c, 12100 - SOC_STILL_MV - 50, 0, t, REST_MS), "moved reading ignored");
+    CHECK(p.pct == soc_from_mv(c, 12100), "estimate kept under load");
+    uint32_t moved = t;
+
+    // still readings, drifting by SOC_STILL_MV at a time: not yet rested
+    uint16_t mv = 12100 - SOC_STILL_MV - 50;
+    while (t + STEP_MS - moved < REST_MS) {
+        t += STEP_MS;
+        mv = mv == 11950 ? 11950 + SOC_STILL_MV : 11950;
+        CHECK(!soc_update(&p, c, mv, 0, t, REST_MS), "update before rest_ms");
+    }
+    CHECK(p.state == SOC_SEED, "still seeded before rest_ms");
+
+    // rest_ms after the last move the reading is OCV
+    t += STEP_MS;
+    CHECK(soc_update(&p, c, 11950, 0, t, REST_MS), "update after rest_ms");
+    CHECK(p.state == SOC_RESTED && p.pct == soc_from_mv(c, 11950), "rested estimate");
+
+    // charging restarts the rest and freezes the estimate
+    uint8_t rested = p.pct;
+    t += STEP_MS;
+    CHECK(!soc_update(&p, c, 13200, 1, t, REST_MS), "update while charging");
+    CHECK(p.pct == rested, "estimate kept while charging");
+    t += STEP_MS;
+    CHECK(!soc_update(&p, c, 13150, 0, t, REST_MS), "off charge, not rested");
+    CHECK(p.pct == rested, "estimate kept after the charge");
+}
+
+static void check_full(void)
+{
+    const soc_curve_t *c = &soc_curves[SOC_FLOODED];
+    soc_pack_t p = { 0 };
+    uint32_t t = 0;
+
+    soc_update(&p, c, 12000, 0, t, REST_MS);
+    uint8_t before = p.pct;
+
+    // charged to the cut-off
+    t += STEP_MS;
+    soc_update(&p, c, 13850, 1, t, REST_MS);
+    soc_full(&p, t);
+    CHECK(p.pct == 100, "100 % at the cut-off");
+
+    // the surface charge sags away: it stays 100 % until rested
+    for (uint16_t mv = 13800; mv > 12800; mv -= 20) {
+        t += STEP_MS;
+        soc_update(&p, c, mv, 0, t, REST_MS);
+        CHECK(p.pct == 100, "100 % while sagging");
+    }
+    CHECK(p.pct != before, "old estimate not restored");
+
+    for (uint32_t end = t + STEP_MS + REST_MS; t < end; ) {   // first reading moves
+        t += STEP_MS;
+        soc_update(&p, c, 12700, 0, t, REST_MS);
+    }
+    CHECK(p.state == SOC_RESTED && p.pct == soc_from_mv(c, 12700), "OCV after the rest");
+}
+
+int main(void)
+{
+    check_tables();
+    check_rest();
+    check_full();
+    if (failed) {
+        printf("%d failed\n", failed);
+        return 1;
+    }
+    printf("rest detector, soc_full: ok\n");
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * File:   telem_gen.c
+ * Author: Rakesh B
+ *
+ * Created on October 26, 2026, 3:00 PM
+ */
+
+// Simulated boards for load-testing collector: opens n pseudo-terminals,
+// prints the path of each slave end, one per line, and streams telemetry
+// frames into them until killed or -t runs out.
+//
+//   telem_gen -n 16 > paths &
+//   collector -t 10 -o logs $(cat paths)
+//
+//   -n  boards (1)
+//   -r  frames/s per board (default: as fast as the reader takes them)
+//   -t  stop after this many seconds
+//
+// Board i is node i and sends battery and temperature frames in turn, as
+// the real boards do. The frames are built once, 256 per board with every
+// sequence number, and replayed, so the generator spends its time writing.
+
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include "frame.h"
+#include "crc.h"
+#include "serial.h"
+
+#define RATE_TICK 0.01                   // s between paced writes
+
+struct board {
+    int fd, slave;
+    uint8_t *frames;                     // 256 frames back to back
+    size_t size;
+    size_t pos;                          // next byte to write
+    double owed;                         // bytes due at the paced rate
+};
+
+static size_t put_frame(uint8_t *buf, uint8_t type, uint8_t node, uint8_t seq,
+                        uint32_t tick, const uint8_t *payload, uint8_t len){
+    uint16_t crc = CRC16_INIT;
+    size_t n = TELEM_HDR_LEN;
+    buf[0] = TELEM_SYNC;
+    buf[1] = len;
+    buf[2] = type;
+    buf[3] = node;
+    buf[4] = seq;
+    buf[5] = (uint8_t)tick;
+    buf[6] = (uint8_t)(tick >> 8);
+    buf[7] = (uint8_t)(tick >> 16);
+    buf[8] = (uint8_t)(tick >> 24);
+    memcpy(buf + n, payload, len);
+    n += len;
+    for(size_t i = 1; i < n; i++) crc = crc16_update(crc, buf[i]);
+    buf[n++] = (uint8_t)crc;
+    buf[n++] = (uint8_t)(crc >> 8);
+    return n;
+}
+
+static void build(struct board *b, uint8_t node){
+    b->frames = malloc(256 * TELEM_FRAME_LEN(TELEM_MAX_PAYLOAD));
+    b->size = 0;
+    for(int seq = 0; seq < 256; seq++){
+        uint8_t p[17];
+        if(seq & 1){
+            p[0] = 8;                    // eight LM35s, around 25 C
+            for(int i = 0; i < 8; i++){
+                uint16_t adc = (uint16_t)(51 + (seq + i) % 5);
+                p[1 + 2 * i] = (uint8_t)adc;
+                p[2 + 2 * i] = (uint8_t)(adc >> 8);
+            }
+            b->size += put_frame(b->frames + b->size, TELEM_TEMP, node, (uint8_t)seq, seq * 500u, p, 17);
+        } else {
+            for(int i = 0; i < 4; i++) p[i] = (uint8_t)(125 + (seq + i) % 10);
+            p[4] = 1;
+            p[5] = 0;
+            b->size += put_frame(b->frames + b->size, TELEM_BATTERY, node, (uint8_t)seq, seq * 500u, p, 6);
+        }
+    }
+}
+
+// Write up to limit bytes from where the board left off; returns bytes written
+static size_t pump(struct board *b, size_t limit){
+    size_t done = 0;
+    while(done < limit){
+        size_t n = b->size - b->pos;
+        if(n > limit - done) n = limit - done;
+        ssize_t w = write(b->fd, b->frames + b->pos, n);
+        if(w <= 0) break;
+        done += (size_t)w;
+        b->pos = (b->pos + (size_t)w) % b->size;
+    }
+    return done;
+}
+
+static void usage(const char *argv0){
+    fprintf(stderr, "usage: %s [-n boards] [-r frames/s] [-t seconds]\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    int count = 1;
+    double rate = 0, run_for = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:r:t:")) != -1){
+        switch(opt){
+        case 'n': count = atoi(optarg); break;
+        case 'r': rate = strtod(optarg, NULL); break;
+        case 't': run_for = strtod(optarg, NULL); break;
+        default:  usage(argv[0]);
+        }
+    }
+    if(optind != argc || count < 1 || count > 256 || rate < 0) usage(argv[0]);
+
+    struct board *boards = calloc((size_t)count, sizeof(*boards));
+    int ep = epoll_create1(0);
+    for(int i = 0; i < count; i++){
+        struct board *b = &boards[i];
+        b->fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if(b->fd < 0 || grantpt(b->fd) < 0 || unlockpt(b->fd) < 0){
+            perror("posix_openpt");
+            return 1;
+        }
+        // Raw mode lives with the terminal, so hold a slave fd open
+        b->slave = serial_open(ptsname(b->fd), 9600, O_RDWR);
+        if(b->slave < 0){
+            perror(ptsname(b->fd));
+            return 1;
+        }
+        printf("%s\n", ptsname(b->fd));
+        build(b, (uint8_t)i);
+        struct epoll_event ev = { .events = EPOLLOUT, .data.ptr = b };
+        if(!rate) epoll_ctl(ep, EPOLL_CTL_ADD, b->fd, &ev);
+    }
+    fflush(stdout);
+
+    // Until the collector opens a slave end, frames wait in the terminal's
+    // input queue (a few kB) and writing stops
+    double start = serial_now();
+    double mean = 0;
+    for(int i = 0; i < count; i++) mean += boards[i].size / 256.0 / count;
+
+    double next = start;
+    while(run_for <= 0 || serial_now() - start < run_for){
+        if(rate){
+            next += RATE_TICK;
+            serial_sleep_until(next);
+            for(int i = 0; i < count; i++){
+                struct board *b = &boards[i];
+                b->owed += rate * mean * RATE_TICK;
+                b->owed -= (double)pump(b, (size_t)b->owed);
+            }
+            continue;
+        }
+        struct epoll_event ev[64];
+        int n = epoll_wait(ep, ev, 64, 100);
+        if(n < 0 && errno != EINTR) break;
+        for(int i = 0; i < n; i++) pump(ev[i].data.ptr, 4096);
+    }
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * File:   telemetry_decode.c
+ * Author: Rakesh B
+ *
+ * Created on October 19, 2026, 11:45 AM
+ */
+
+// Decode telemetry frames from a serial port, a captured byte stream or
+// stdin, one line per frame.
+//
+//   telemetry_decode /dev/ttyUSB0            live, 9600 baud
+//   telemetry_decode -b 115200 /dev/ttyUSB0
+//   telemetry_decode -c capture.bin          CSV
+//   telemetry_decode -r -x 10 capture.bin    replay at 10x board time
+//
+// A capture is just the raw bytes off the wire (e.g. cat /dev/ttyUSB0).
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "frame.h"
+#include "serial.h"
+#include "crc.h"
+#include "journal.h"
+
+struct decode_ctx {
+    int csv;
+    int replay;
+    double speed;
+    int have_prev;
+    uint32_t prev_tick;
+    int seen[256];               // per node: a frame has been seen
+    uint8_t last_seq[256];
+    unsigned long lost;
+};
+
+static int open_input(const char *path, long baud){
+    if(strcmp(path, "-") == 0) return STDIN_FILENO;
+    return serial_open(path, baud, O_RDONLY);
+}
+
+static void replay_wait(struct decode_ctx *c, uint32_t tick){
+    if(c->have_prev && tick > c->prev_tick){
+        double s = (tick - c->prev_tick) / 1000.0 / c->speed;
+        struct timespec ts = { (time_t)s, (long)((s - (time_t)s) * 1e9) };
+        nanosleep(&ts, NULL);
+    }
+    c->prev_tick = tick;
+    c->have_prev = 1;
+}
+
+static void print_faults(uint8_t faults){
+    static const char *const names[] = { "low", "sense", "uncal" };   // BATT_* bit order
+    const char *sep = " faults=";
+    for(int i = 0; i < 8; i++){
+        if(!(faults & (1 << i))) continue;
+        if(i < 3) printf("%s%s", sep, names[i]);
+        else printf("%sbit%d", sep, i);
+        sep = ",";
+    }
+}
+
+static void print_battery(const struct telem_frame *f, int csv){
+    const uint8_t *p = f->payload;
+    if(f->len < 5) return;
+    if(csv){
+        printf("%u.%u,%u.%u,%u.%u,%u.%u,%u", p[0] / 10, p[0] % 10, p[1] / 10, p[1] % 10,
+               p[2] / 10, p[2] % 10, p[3] / 10, p[3] % 10, p[4]);
+        if(f->len >= 6) printf(",%u", p[5]);
+        return;
+    }
+    for(int i = 0; i < 4; i++){
+        printf(" B%d=%u.%uV", i + 1, p[i] / 10, p[i] % 10);
+    }
+    if(p[4]) printf(" charging=B%u", p[4]);
+    else printf(" charging=none");
+    if(f->len >= 6 && p[5]) print_faults(p[5]);   // older firmware sends no fault byte
+}
+
+static void print_temp(const struct telem_frame *f, int csv){
+    const uint8_t *p = f->payload;
+    unsigned n = f->len ? p[0] : 0;
+    for(unsigned i = 0; i < n && 1 + 2 * i + 1 < f->len; i++){
+        unsigned adc = p[1 + 2 * i] | (p[2 + 2 * i] << 8);
+        double c = adc * 500.0 / 1023.0;   // LM35, 10mV/C, 5V reference
+        if(csv) printf("%s%.1f", i ? "," : "", c);
+        else printf(" ch%u=%.1fC", i, c);
+    }
+}
+
+static void print_sample(uint8_t kind, int v, int first, int csv){
+    if(kind == TELEM_TEMP){
+        printf(csv ? "%s%.1f" : "%s%.1fC", first ? "" : (csv ? "," : " "), v * 500.0 / 1023.0);
+    } else {
+        printf("%s%d", first ? "" : (csv ? "," : " "), v);
+    }
+}
+
+// One eelog page: seq, count, first sample, zigzag varint deltas
+static void print_log(const struct telem_frame *f, int csv){
+    const uint8_t *p = f->payload;
+    if(f->len < 1 + 4) return;
+    uint8_t kind = p[0];
+    const uint8_t *page = p + 1;
+    size_t size = f->len - 1;
+    unsigned count = page[1];
+    int v = (int16_t)(page[2] | (page[3] << 8));
+    size_t pos = 4;
+
+    if(csv) printf("%u,%u,", page[0], count);
+    else if(page[0] == 0xFF) printf(" LOG unsaved n=%u:", count);
+    else printf(" LOG seq=%u n=%u:", page[0], count);
+    if(!csv) printf(" ");
+    for(unsigned i = 0; i < count; i++){
+        if(i){
+            uint16_t z = 0;
+            int shift = 0;
+            do {
+                if(pos >= size) return;
+                z |= (uint16_t)((page[pos] & 0x7F) << shift);
+                shift += 7;
+            } while(page[pos++] & 0x80);
+            v += (int16_t)((z >> 1) ^ -(z & 1));
+        }
+        print_sample(kind, v, i == 0, csv);
+    }
+}
+
+// Probe statistics, Timer1 counts of 1.6 us
+static void print_probe(const struct telem_frame *f, int csv){
+    const uint8_t *p = f->payload;
+    if(f->len < 11 + 16) return;
+    unsigned count = p[1] | (p[2] << 8);
+    unsigned min = p[3] | (p[4] << 8);
+    unsigned max = p[5] | (p[6] << 8);
+    uint32_t sum = p[7] | (p[8] << 8) | ((uint32_t)p[9] << 16) | ((uint32_t)p[10] << 24);
+    int name_len = f->len - 27;
+    double avg = count ? (double)sum / count : 0;
+
+    if(csv){
+        printf("%.*s,%u,%.1f,%.1f,%.1f", name_len, (const char *)p + 27, count,
+               count ? min * 1.6 : 0, avg * 1.6, max * 1.6);
+        for(int i = 0; i < 16; i++) printf(",%u", p[11 + i]);
+        return;
+    }
+    printf(" PROBE %u %.*s n=%u", p[0], name_len, (const char *)p + 27, count);
+    if(count) printf(" min=%.1fus avg=%.1fus max=%.1fus", min * 1.6, avg * 1.6, max * 1.6);
+    printf(" log2:");
+    for(int i = 0; i < 16; i++) printf(" %u", p[11 + i]);
+}
+
+// One journal record; the RFID board logs ms since boot, the tag's five
+// ID bytes and checksum, and the verdict
+static void print_journal(const struct telem_frame *f, int csv){
+    const uint8_t *p = f->payload;
+    const uint8_t *d = p + 4;
+    uint16_t crc = CRC16_INIT;
+    if(f->len < JOURNAL_REC) return;
+    for(int i = 0; i < JOURNAL_REC - 1; i++) crc = crc16_update(crc, p[i]);
+    uint32_t seq = p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    uint32_t ms = d[0] | (d[1] << 8) | ((uint32_t)d[2] << 16) | ((uint32_t)d[3] << 24);
+    const char *ok = (uint8_t)crc == p[JOURNAL_REC - 1] ? "" : " BAD";
+
+    if(csv){
+        printf("%lu,%.3f,", (unsigned long)seq, ms / 1000.0);
+        for(int i = 4; i < 10; i++) printf("%02X", d[i]);
+        printf(",%u,%d", d[10], !*ok);
+        return;
+    }
+    printf(" JOURNAL #%lu t=%.3fs tag=", (unsigned long)seq, ms / 1000.0);
+    for(int i = 4; i < 10; i++) printf("%02X", d[i]);
+    printf(" %s%s", d[10] ? "granted" : "denied", ok);
+}
+
+static void on_frame(const struct telem_frame *f, void *arg){
+    struct decode_ctx *c = arg;
+
+    if(c->seen[f->node]){
+        uint8_t gap = (uint8_t)(f->seq - c->last_seq[f->node] - 1);
+        if(gap){
+            c->lost += gap;
+            if(!c->csv) printf("# node %u: %u frame(s) lost before seq %u\n", f->node, gap, f->seq);
+        }
+    }
+    c->seen[f->node] = 1;
+    c->last_seq[f->node] = f->seq;
+
+    if(c->replay) replay_wait(c, f->tick);
+
+    if(c->csv){
+        printf("%lu,%u,%u,%u,", (unsigned long)f->tick, f->node, f->seq, f->type);
+    } else {
+        printf("%10.3fs node=%u seq=%3u", f->tick / 1000.0, f->node, f->seq);
+    }
+    switch(f->type){
+    case TELEM_BATTERY: if(!c->csv) printf(" BATTERY"); print_battery(f, c->csv); break;
+    case TELEM_TEMP:    if(!c->csv) printf(" TEMP");    print_temp(f, c->csv);    break;
+    case TELEM_LOG:     print_log(f, c->csv); break;
+    case TELEM_PROBE:   print_probe(f, c->csv); break;
+    case TELEM_JOURNAL: print_journal(f, c->csv); break;
+    default:
+        if(!c->csv) printf(" type=0x%02X len=%u", f->type, f->len);
+        break;
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void usage(const char *argv0){
+    fprintf(stderr, "usage: %s [-b baud] [-c] [-r [-x speed]] <device|capture|->\n", argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    struct decode_ctx ctx;
+    long baud = 9600;
+    int opt;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.speed = 1.0;
+    while((opt = getopt(argc, argv, "b:crx:")) != -1){
+        switch(opt){
+        case 'b': baud = strtol(optarg, NULL, 10); break;
+        case 'c': ctx.csv = 1; break;
+        case 'r': ctx.replay = 1; break;
+        case 'x': ctx.speed = strtod(optarg, NULL); break;
+        default:  usage(argv[0]);
+        }
+    }
+    if(optind != argc - 1 || ctx.speed <= 0) usage(argv[0]);
+
+    int fd = open_input(argv[optind], baud);
+    if(fd < 0){
+        fprintf(stderr, "%s: %s\n", argv[optind], strerror(errno));
+        return 1;
+    }
+    if(ctx.csv) printf("tick_ms,node,seq,type,values\n");
+
+    struct frame_parser parser;
+    uint8_t buf[4096];
+    ssize_t n;
+    frame_parser_init(&parser);
+    while((n = read(fd, buf, sizeof(buf))) > 0){
+        frame_feed(&parser, buf, (size_t)n, on_frame, &ctx);
+    }
+
+    fprintf(stderr, "%lu frames, %lu crc errors, %lu bytes skipped, %lu frames lost\n",
+            parser.frames, parser.crc_errors, parser.skipped, ctx.lost);
+    return 0;
+}
@@ -20,10 +20,15 @@
 #include <xc.h>
 #define _XTAL_FREQ 20000000     // 20 MHz crystal
 
-// LCD control pins
-#define RS RD0
-#define RW RD1
-#define EN RD2
+#include "board.h"
+#include "common/sched.h"
+#include "common/probe.h"
+#include "common/lcd.h"
+#include "common/calc.h"
+#include "common/irq.h"
+
+#define KEYPAD_PERIOD_MS 10     // matrix scan rate
+#define KEY_DEBOUNCE 3          // scans a key must stay down before it counts
 
 // Keypad pins
 #define C1 RB0
@@ -35,92 +40,211 @@
 #define R3 RB6
 #define R4 RB7
 
-// -------- LCD Functions --------
-void lcd_cmd(unsigned char cmd){
-    PORTC = cmd;
-    RS = 0;
-    RW = 0;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
-
-void lcd_data(unsigned char data){
-    PORTC = data;
-    RS = 1;
-    RW = 0;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
-
-void lcd_string(const char *str){
-    while(*str){
-        lcd_data(*str++);
+// Cycle probes (built with -DPROBES). The LCD bus takes RC6/RC7, so this
+// board has no USART to dump them on; read the table with the debugger.
+// calc_key times the engine alone, LCD writes excluded; calc_mul, calc_div
+// and calc_format each time their worst case once at reset (calc_worst).
+// Ids in board.h.
+#ifdef PROBES
+probe_t probes[] = { PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("keypad"), PROBE("calc_key"),
+                     PROBE("calc_mul"), PROBE("calc_div"), PROBE("calc_format") };
+
+// Longest run of each loop in calc.c, before interrupts are on: 46340^2
+// is the largest square that fits (16 rounds), INT32_MAX^2 overflows
+// after 31, INT32_MAX / 1 and -2^31 take all 32
+void calc_worst(void){
+    uint8_t err = 0;
+    char buf[12];
+    {
+        PROBE_ENTER(P_CALC_MUL);
+        calc_mul(46340, 46340, &err);
+        PROBE_EXIT(P_CALC_MUL);
+    }
+    {
+        PROBE_ENTER(P_CALC_MUL);
+        calc_mul(INT32_MAX, INT32_MAX, &err);
+        PROBE_EXIT(P_CALC_MUL);
+    }
+    {
+        PROBE_ENTER(P_CALC_DIV);
+        calc_div(INT32_MAX, 1, &err);
+        PROBE_EXIT(P_CALC_DIV);
+    }
+    {
+        PROBE_ENTER(P_CALC_FORMAT);
+        calc_format(buf, INT32_MIN, 11);
+        PROBE_EXIT(P_CALC_FORMAT);
     }
 }
-
-void lcd_initialize(){
-    lcd_cmd(0x38); // 8-bit, 2-line, 5x7
-    lcd_cmd(0x06); // Increment cursor
-    lcd_cmd(0x0C); // Display ON, cursor OFF
-    lcd_cmd(0x01); // Clear screen
-    __delay_ms(2);
-}
+#endif
 
 // -------- Keypad Scan Function --------
+// Returns the key currently held (first found), 0 when none. No waiting
+// for release here - keypad_task() turns this into press events.
 char keypad(){
     // Column 1
     C1=1; C2=0; C3=0; C4=0;
-    if(R1==1){ while(R1==1); return '7'; }
-    if(R2==1){ while(R2==1); return '4'; }
-    if(R3==1){ while(R3==1); return '1'; }
-    if(R4==1){ while(R4==1); return 'C'; }
+    if(R1==1) return '7';
+    if(R2==1) return '4';
+    if(R3==1) return '1';
+    if(R4==1) return 'C';
 
     // Column 2
     C1=0; C2=1; C3=0; C4=0;
-    if(R1==1){ while(R1==1); return '8'; }
-    if(R2==1){ while(R2==1); return '5'; }
-    if(R3==1){ while(R3==1); return '2'; }
-    if(R4==1){ while(R4==1); return '0'; }
+    if(R1==1) return '8';
+    if(R2==1) return '5';
+    if(R3==1) return '2';
+    if(R4==1) return '0';
 
     // Column 3
     C1=0; C2=0; C3=1; C4=0;
-    if(R1==1){ while(R1==1); return '9'; }
-    if(R2==1){ while(R2==1); return '6'; }
-    if(R3==1){ while(R3==1); return '3'; }
-    if(R4==1){ while(R4==1); return '='; }
+    if(R1==1) return '9';
+    if(R2==1) return '6';
+    if(R3==1) return '3';
+    if(R4==1) return '=';
 
     // Column 4
     C1=0; C2=0; C3=0; C4=1;
-    if(R1==1){ while(R1==1); return '/'; }
-    if(R2==1){ while(R2==1); return '*'; }
-    if(R3==1){ while(R3==1); return '-'; }
-    if(R4==1){ while(R4==1); return '+'; }
+    if(R1==1) return '/';
+    if(R2==1) return '*';
+    if(R3==1) return '-';
+    if(R4==1) return '+';
 
     return 0; // no key pressed
 }
 
+// -------- Tasks --------
+char key_last = 0;       // key seen on the previous scan
+unsigned char key_count = 0;
+char key_pending = 0;    // debounced press waiting for the display
+
+enum { TASK_KEYPAD, TASK_DISPLAY };
+
+// A key registers once it has been down for KEY_DEBOUNCE scans, and only
+// again after it has been released
+void keypad_task(void){
+    PROBE_ENTER(P_KEYPAD);
+    char key = keypad();
+    PROBE_EXIT(P_KEYPAD);
+    if(key != key_last){
+        key_last = key;
+        key_count = 0;
+        return;
+    }
+    if(key && key_count < KEY_DEBOUNCE && ++key_count == KEY_DEBOUNCE){
+        key_pending = key;
+        sched_wake(TASK_DISPLAY, 0);
+    }
+}
+
+// -------- Calculator display --------
+// Row 1 echoes the expression (scrolling left once full), row 2 shows the
+// result or the error after '='.
+calc_t calc;
+char expr[16];
+unsigned char expr_len = 0;
+unsigned char splash = 1;     // "Calculator / Ready..." until the first key
+
+void expr_clear(void){
+    lcd_cmd(0x01);
+    expr_len = 0;
+}
+
+void expr_put(char c){
+    if(expr_len < sizeof(expr)){
+        expr[expr_len++] = c;
+        lcd_data(c);
+        return;
+    }
+    for(unsigned char i = 1; i < sizeof(expr); i++) expr[i - 1] = expr[i];
+    expr[sizeof(expr) - 1] = c;
+    lcd_cmd(0x80);
+    for(unsigned char i = 0; i < sizeof(expr); i++) lcd_data(expr[i]);
+}
+
+void show_result(unsigned char err){
+    char buf[17];
+    lcd_cmd(0xC0);
+    if(err == CALC_OVERFLOW) lcd_string("Overflow");
+    else if(err == CALC_DIV0) lcd_string("Divide by zero");
+    else {
+        calc_format(buf, calc_result(&calc), 16);
+        lcd_string(buf);
+    }
+}
+
+void display_task(void){
+    char key = key_pending;
+    if(!key) return;
+    key_pending = 0;
+
+    if(splash){
+        expr_clear();
+        splash = 0;
+    }
+    unsigned char was_error = calc.error, was_done = calc.done;
+    char was_op = calc.op;
+    PROBE_ENTER(P_CALC_KEY);
+    unsigned char err = calc_key(&calc, key);
+    PROBE_EXIT(P_CALC_KEY);
+
+    if(key == 'C'){
+        expr_clear();
+    } else if(was_error){
+        // ignored until 'C'
+    } else if(key == '='){
+        if(!was_done){
+            expr_put('=');
+            show_result(err);
+        }
+    } else if(key >= '0' && key <= '9'){
+        if(was_done) expr_clear();
+        expr_put(key);
+        if(err) show_result(err);
+    } else if(was_done){
+        // operator after '=': the result becomes the first operand
+        char buf[12];
+        calc_format(buf, calc.entry, 0);
+        expr_clear();
+        for(char *p = buf; *p; p++) expr_put(*p);
+        expr_put(key);
+    } else if(was_op && expr_len){
+        expr[expr_len - 1] = key;     // second operator replaces the first
+        lcd_cmd(0x80 + expr_len - 1);
+        lcd_data(key);
+    } else {
+        expr_put(key);
+    }
+}
+
+sched_task_t tasks[] = {
+    SCHED_TASK(keypad_task, KEYPAD_PERIOD_MS, 0, 200),
+    SCHED_ONESHOT(display_task, 3000),
+};
+
 // -------- Main Program --------
 void main(void){
-    TRISC = 0x00;   // LCD data port
-    TRISD = 0x00;   // LCD control port
+    TRISD = 0x00;   // LCD control, spare pins output
     TRISB = 0xF0;   // RB7-RB4 input (rows), RB3-RB0 output (cols)
     PORTB = 0x00;   // clear keypad port
 
-    lcd_initialize();
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
+    lcd_init();
     lcd_cmd(0x80);
     lcd_string("Calculator");
 
     lcd_cmd(0xC0);
     lcd_string("Ready...");
 
-    char key;
+    tick_init();
+#ifdef PROBES
+    calc_worst();
+#endif
+    irq_register(IRQ_TMR2, tick_isr);
+    ei();
+    calc_clear(&calc);
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
     while(1){
-        key = keypad();
-        if(key){
-            lcd_data(key);   // display key on LCD
-            __delay_ms(200);
-        }
+        sched_run();
     }
 }
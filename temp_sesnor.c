@@ -27,117 +27,229 @@
 #include <xc.h>
 #define _XTAL_FREQ 20000000
 
-// LCD connections
-#define RS RC0
-#define RW RC1
-#define EN RC2
-
-#define LCD PORTD
-
-// LCD Functions
-void lcd_cmd(char cmd) {
-    RS = 0;
-    RW = 0;
-    LCD = cmd;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
+#include "board.h"
+#include "common/tick.h"
+#include "common/uart.h"
+#include "common/telemetry.h"
+#include "common/eelog.h"
+#include "common/sched.h"
+#include "common/fmt.h"
+#include "common/probe.h"
+#include "common/lcd.h"
+#include "common/adc.h"
+#include "common/console.h"
+#include "common/runstat.h"
+#include "common/irq.h"
+
+#define SCAN_PERIOD_MS 25      // one channel per run, so 8 channels every 200 ms
+#define TELEM_PERIOD_MS 1000   // telemetry frame rate on the USART
+#ifndef LOG_PERIOD_S
+#define LOG_PERIOD_S 60        // one logged sample a minute, ~3 h of history
+#endif
+#define DUMP_CMD 'D'           // received on the USART: stream the log out
+
+// Cycle probes (built with -DPROBES, dumped with 'P' on the USART); ids
+// in board.h
+#ifdef PROBES
+probe_t probes[] = { PROBE("lcd_cmd"), PROBE("lcd_data"), PROBE("adc_read") };
+#endif
+
+// Hysteresis band and alarm thresholds in tenths of a degree (console
+// settings); alarm_lo = 0 is off
+uint16_t hyst = 5;
+uint16_t alarm_hi = 500;
+uint16_t alarm_lo = 0;
+
+// Tasks
+unsigned int last_adc[TEMP_CHANNELS];
+runstat_t ch_stats[TEMP_CHANNELS];
+unsigned int shown[TEMP_CHANNELS];   // tenths of a degree last put on the LCD
+unsigned char alarm_mask;            // channels past a threshold
+unsigned char redraw;                // channels whose LCD cell is out of date
+
+// LM35: 10 mV/C, so millivolts are also tenths of a degree.
+// 5000/1023 mV per count ~= 5005/1024, a multiply and a shift.
+unsigned int adc_to_mv(unsigned int adc_val) {
+    return (unsigned int)(((unsigned long)adc_val * 5005) >> 10);
 }
 
-void lcd_data(char data) {
-    RS = 1;
-    RW = 0;
-    LCD = data;
-    EN = 1;
-    __delay_ms(2);
-    EN = 0;
-}
+// Convert with the core asleep (adc_sleep setting) unless a console line
+// may be arriving: the USART's baud clock stops in SLEEP as well. A byte
+// still being shifted in cannot be seen, so the first byte of a command
+// that overlaps a conversion is lost; off unless nothing talks to the board.
+unsigned char adc_sleep = 0;
 
-void lcd_init() {
-    lcd_cmd(0x38); // 8-bit, 2-line
-    lcd_cmd(0x0C); // display ON
-    lcd_cmd(0x06); // entry mode
-    lcd_cmd(0x01); // clear display
+unsigned int sample(unsigned char ch) {
+    if (adc_sleep && !uart_rx_ready() && !console_in_line()) return adc_read_sleep(ch);
+    return adc_read(ch);
 }
 
-void lcd_string(const char *str){
-    while(*str)
-        lcd_data(*str++);
+// One channel per run. A reading only marks its LCD cell for redraw when
+// it has moved hyst or more from the value on screen, or the channel went
+// into or out of alarm; thresholds trip at the limit and clear hyst inside
+// it, so a reading sitting on a limit does not flicker.
+void sense_task(void) {
+    static unsigned char ch = 0;
+    unsigned char bit = 1 << ch;
+    unsigned char alarm = alarm_mask & bit;
+    unsigned int adc = sample(ch);
+    unsigned int mv = adc_to_mv(adc);
+
+    last_adc[ch] = adc;
+    runstat_add(&ch_stats[ch], adc);
+
+    if (mv >= alarm_hi || (alarm_lo && mv <= alarm_lo)) alarm = bit;
+    else if (mv + hyst < alarm_hi && (!alarm_lo || mv > alarm_lo + hyst)) alarm = 0;
+
+    if (alarm != (alarm_mask & bit) || mv >= shown[ch] + hyst || mv + hyst <= shown[ch]) {
+        alarm_mask = (alarm_mask & ~bit) | alarm;
+        ALARM_PIN = alarm_mask != 0;
+        shown[ch] = mv;
+        redraw |= bit;
+    }
+    if (++ch == TEMP_CHANNELS) ch = 0;
 }
 
-void lcd_print_num(unsigned int num) {
-    char digits[5];
-    int i = 0;
+// Four characters per channel, four channels a line: whole degrees and
+// '*' in alarm. One out-of-date cell per run (5 LCD writes, ~10 ms); with
+// steady readings this returns without touching the LCD.
+void display_task(void) {
+    static unsigned char ch = 0;
+    char buf[6];
+    unsigned char bit;
+
+    if (!redraw) return;
+    do {
+        if (++ch == TEMP_CHANNELS) ch = 0;
+        bit = 1 << ch;
+    } while (!(redraw & bit));
+    redraw &= ~bit;
+    lcd_cmd((ch < 4 ? 0x80 : 0xC0) + (ch & 3) * 4);
+    fmt_u16(buf, shown[ch] + 5, 4, ' ');   // rounded tenths; the last digit is dropped
+    if (buf[2] == ' ') buf[2] = '0';
+    buf[3] = '\0';
+    lcd_string(buf);
+    lcd_data(alarm_mask & bit ? '*' : ' ');
+}
 
-    if (num == 0) {
-        lcd_data('0');
-        return;
+void telemetry_task(void) {
+    unsigned char payload[1 + 2 * TEMP_CHANNELS];   // channel count, adc lo/hi each
+    payload[0] = TEMP_CHANNELS;
+    for (unsigned char i = 0; i < TEMP_CHANNELS; i++) {
+        payload[1 + 2 * i] = last_adc[i] & 0xFF;
+        payload[2 + 2 * i] = last_adc[i] >> 8;
     }
+    telem_send(TELEM_TEMP, payload, sizeof(payload));
+}
 
-    while (num > 0) {
-        digits[i++] = (num % 10) + '0';   //number are stored in reverse order ,& here each numbers are in char form
-        num /= 10;                        //removes the last digit 
-    }
+// Runs every second; the scheduler cannot release anything slower than
+// 32 s directly
+void log_task(void) {
+    static unsigned char secs = 0;
+    if (++secs < LOG_PERIOD_S) return;
+    secs = 0;
+    eelog_add(last_adc[0]);
+}
 
-    for (int j = i - 1; j >= 0; j--) {    //loop runs to convert the reverse order char into normal result
-        lcd_data(digits[j]);
-    }
+char *put_str(char *p, const char *s) {
+    while (*s) *p++ = *s++;
+    return p;
 }
 
-// ADC Functions
-void adc_init() {
-    ADCON0 = 0x41; // ADC ON, Channel 0
-    ADCON1 = 0x80; // Right justified, Vref = Vdd
+// "ch <n>": channel n's statistics in degrees as min/mean/max, e.g.
+// "ch0 n=1024 24.4/25.1/25.9 sd=0.31". min and max are since boot, mean
+// and sd over the last RUNSTAT_WINDOW readings or so.
+const char *ch_cmd(const char *arg) {
+    static char reply[40];
+    uint32_t n;
+    char *p;
+
+    if (!console_number(arg, &n) || n >= TEMP_CHANNELS) return "ERR range";
+    const runstat_t *s = &ch_stats[n];
+    p = fmt_u8(put_str(reply, "ch"), (unsigned char)n, 1, ' ');
+    p = fmt_u16(put_str(p, " n="), s->n, 1, ' ');
+    if (!s->n) return reply;
+    p = fmt_fixed(put_str(p, " "), adc_to_mv(s->min), 1, 1, ' ');
+    p = fmt_fixed(put_str(p, "/"), adc_to_mv(runstat_mean(s)), 1, 1, ' ');
+    p = fmt_fixed(put_str(p, "/"), adc_to_mv(s->max), 1, 1, ' ');
+    // sd16 counts x 5005/1024 mV / 16, in hundredths of a degree
+    fmt_fixed(put_str(p, " sd="), (unsigned int)(((unsigned long)runstat_sd16(s) * 50050) >> 14),
+              1, 2, ' ');
+    return reply;
 }
 
-unsigned int adc_read() {
-    GO_nDONE = 1;
-    while (GO_nDONE);
-    return ((ADRESH << 8) + ADRESL);
+// EEPROM page writes, log and probe dumps, console. 'D' at the start of a
+// line streams the log out; anything else goes to the console.
+void service_task(void) {
+    eelog_poll();
+    while (!console_in_line() && uart_rx_ready()) {
+        unsigned char c = uart_rx();
+        if (c == DUMP_CMD) eelog_dump_start(TELEM_TEMP);
+        else console_byte(c);
+    }
+    while (console_in_line() && !console_line_waiting() && uart_rx_ready()) console_byte(uart_rx());
+    console_poll();
 }
 
+enum { TASK_SERVICE, TASK_SENSE, TASK_TELEM, TASK_LOG, TASK_DISPLAY };
+
+sched_task_t tasks[] = {
+    SCHED_TASK(service_task,   5,               0,   500),
+    SCHED_TASK(sense_task,     SCAN_PERIOD_MS,  1,   150),
+    SCHED_TASK(telemetry_task, TELEM_PERIOD_MS, 20,  1000),
+    SCHED_TASK(log_task,       1000,            30,  200),
+    SCHED_TASK(display_task,   25,              3,   2000),
+};
+
+// Console settings, saved in data EEPROM above the log
+const console_var_t settings[] = {
+    CONSOLE_U16("hyst", hyst, 1, 100),
+    CONSOLE_U16("alarm_hi", alarm_hi, 1, 1500),
+    CONSOLE_U16("alarm_lo", alarm_lo, 0, 1500),
+    CONSOLE_U16("telem_ms", tasks[TASK_TELEM].period, 100, 30000),
+    CONSOLE_U8("adc_sleep", adc_sleep, 0, 1),
+};
+
+const console_stat_t counters[] = {
+    CONSOLE_STAT("telem_drop", telem_dropped),
+    CONSOLE_STAT("rx_drop", uart_rx_dropped),
+    CONSOLE_STAT("rx_over", uart_rx_overruns),
+    CONSOLE_STAT("adc_awake", adc_sleep_missed),
+    CONSOLE_STAT("irq_lost", irq_unhandled),
+};
+
+const console_cmd_t commands[] = {
+    CONSOLE_CMD("ch", ch_cmd),
+#ifdef IRQ_STATS
+    CONSOLE_CMD("irq", irq_cmd),
+#endif
+};
+
 void main() {
-    TRISD = 0x00; // LCD output
-    TRISC = 0x00; // Control output
-    TRISA0 = 1;   // RA0 input
+    TRISC = 0x00; // spare pins output, uart_init() takes RC6/RC7
+    TRISA = 0xFF; // AN0-AN4 inputs
+    TRISE = 0x07; // AN5-AN7 inputs
 
+    probe_init(probes, sizeof(probes) / sizeof(probes[0]));
     lcd_init();
-    adc_init();
-
+    adc_init(0x00);   // AN0-AN7 analog
+    eelog_init();
+    for (unsigned char i = 0; i < TEMP_CHANNELS; i++) {
+        runstat_reset(&ch_stats[i]);
+        shown[i] = 0xFFFF;        // first reading of each channel is drawn
+    }
+    tick_init();
+    uart_init();
+    console_init(settings, sizeof(settings) / sizeof(settings[0]),
+                 counters, sizeof(counters) / sizeof(counters[0]), 0);
+    console_commands(commands, sizeof(commands) / sizeof(commands[0]));
+    irq_register(IRQ_TMR2, tick_isr);
+    irq_register(IRQ_RX, uart_rx_isr);
+    irq_register(IRQ_TX, uart_tx_isr);
+    ei();
+
+    sched_init(tasks, sizeof(tasks) / sizeof(tasks[0]));
     while (1) {
-        unsigned int adc_val = adc_read();
-        
-       // ? Calculate Voltage and Temperature
-        
-        float temp = adc_val * 0.488;            
-        int t_int = (int)temp;                    // Integer part
-
-        // ? Display on LCD
-        lcd_cmd(0x01);                // Clear LCD
-        lcd_string("Temp: ");
-        lcd_print_num(t_int);
-        lcd_data(0xDF);               // Degree symbol
-        lcd_data('C');
-
-        lcd_cmd(0xC0);                // Move to 2nd line
-        lcd_string("Volt: ");
-
-        // Convert voltage to show 1 decimal place
-        
-        float voltage;
-        int whole, decimal;
-
-        voltage = (adc_val * 5.0) / 1023.0;   // Convert ADC to voltage
-
-        whole = (int)voltage;                   // Take integer part ? e.g. 2
-        decimal = (voltage * 100) - (whole * 100); // Get two digits after decimal ? e.g. 56
-
-        lcd_print_num(whole);                   // Print integer part
-        lcd_data('.');                          // Print decimal point
-        lcd_print_num(decimal);                 // Print decimal digits
-        lcd_data('V');                          // Print unit
-
-
-        __delay_ms(1000);
+        sched_run();
     }
 }